@@ -0,0 +1,267 @@
+/*
+ * bench/bench.c
+ *
+ * Microbenchmarks for every scheduling engine (schedule_run_table, named
+ * schedule_<alg> in the output) and calculate_metrics_table over generated
+ * SoA workloads of 10^3 .. 10^7 processes.  Results are written as
+ * JSON (one object per function and size) so runs can be diffed across
+ * commits.  Built with -O2 by `make bench`.
+ *
+ * Usage:
+ *   bench [-m max_n] [-w warmup] [-r min_reps] [-R max_reps] [-t min_seconds]
+ *         [-o file]
+ *     -m N   largest workload, rounded down to a power of ten (default 10^7)
+ *     -w N   untimed warmup runs per case (default 1)
+ *     -r N   minimum timed repetitions (default 3)
+ *     -R N   maximum timed repetitions (default 50)
+ *     -t S   keep repeating until the timed runs add up to S seconds, within
+ *            [min_reps, max_reps] (default 0.5)
+ *     -o F   write JSON to F instead of stdout
+ *
+ * Reported per case: median and minimum ns per process, ns per event
+ * (scheduled slice) and events per second from the median run, and the
+ * peak RSS reached during the case.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "generator.h"
+
+typedef struct {
+    int warmup;
+    int min_reps;
+    int max_reps;
+    double min_seconds;
+} bench_opts_t;
+
+typedef struct {
+    const char *name;
+    int n;
+    long long events;
+    int reps;
+    double median_ns;       // Por ejecución completa
+    double min_ns;
+    long peak_rss_kb;
+} bench_result_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void count_event(void *ctx, const timeline_event_t *ev) {
+    (void)ev;
+    (*(long long *)ctx)++;
+}
+
+// -----------------------------
+// Memoria
+// -----------------------------
+// En Linux el pico (VmHWM) se puede reiniciar escribiendo 5 en clear_refs,
+// lo que da un pico por caso; si no, se usa el pico de todo el proceso.
+static void rss_reset_peak(void) {
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+}
+
+static long rss_peak_kb(void) {
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f) {
+        char line[256];
+        long kb = -1;
+        while (fgets(line, sizeof(line), f))
+            if (sscanf(line, "VmHWM: %ld kB", &kb) == 1)
+                break;
+        fclose(f);
+        if (kb >= 0)
+            return kb;
+    }
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+// -----------------------------
+// Medición
+// -----------------------------
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Repite run(ctx) según opts y rellena tiempos y número de repeticiones
+static void measure(const bench_opts_t *opts, void (*run)(void *), void *ctx,
+                    bench_result_t *res) {
+    double *samples = malloc(opts->max_reps * sizeof(double));
+    if (!samples) {
+        perror("malloc");
+        exit(1);
+    }
+    for (int i = 0; i < opts->warmup; i++)
+        run(ctx);
+
+    double total = 0.0;
+    int reps = 0;
+    while (reps < opts->max_reps &&
+           (reps < opts->min_reps || total < opts->min_seconds)) {
+        double t0 = now_seconds();
+        run(ctx);
+        samples[reps] = now_seconds() - t0;
+        total += samples[reps++];
+    }
+    qsort(samples, reps, sizeof(double), cmp_double);
+    res->reps = reps;
+    res->median_ns = (reps % 2 ? samples[reps / 2]
+                               : (samples[reps / 2 - 1] + samples[reps / 2]) / 2) * 1e9;
+    res->min_ns = samples[0] * 1e9;
+    free(samples);
+}
+
+// Los motores reinician remaining y no tocan la entrada, así que cada
+// repetición planifica la misma tabla sin preparación
+typedef struct {
+    sched_alg_t alg;
+    proc_table_t *pt;
+    mlfq_config_t *config;
+    int makespan;
+} bench_case_t;
+
+static void case_schedule(void *ctx) {
+    bench_case_t *c = ctx;
+    schedule_run_table(c->alg, c->pt, 3, c->config, NULL);
+}
+
+static void case_metrics(void *ctx) {
+    bench_case_t *c = ctx;
+    metrics_t m;
+    calculate_metrics_table(c->pt, c->makespan, &m);
+}
+
+// -----------------------------
+// Salida
+// -----------------------------
+static void print_result(FILE *out, const bench_result_t *r, int first) {
+    double ns_per_event = r->events > 0 ? r->median_ns / r->events : 0.0;
+    fprintf(out, "%s    {\"name\": \"%s\", \"n\": %d, \"events\": %lld, \"reps\": %d, "
+                 "\"ns_per_process\": %.3f, \"ns_per_process_min\": %.3f, "
+                 "\"ns_per_event\": %.3f, \"events_per_second\": %.0f, "
+                 "\"peak_rss_kb\": %ld}",
+            first ? "" : ",\n", r->name, r->n, r->events, r->reps,
+            r->median_ns / r->n, r->min_ns / r->n, ns_per_event,
+            ns_per_event > 0 ? 1e9 / ns_per_event : 0.0, r->peak_rss_kb);
+    fflush(out);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-m max_n] [-w warmup] [-r min_reps] [-R max_reps] "
+                    "[-t min_seconds] [-o file]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    bench_opts_t opts = { 1, 3, 50, 0.5 };
+    long max_n = 10000000;
+    const char *out_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:w:r:R:t:o:h")) != -1) {
+        switch (opt) {
+            case 'm': max_n = atol(optarg); break;
+            case 'w': opts.warmup = atoi(optarg); break;
+            case 'r': opts.min_reps = atoi(optarg); break;
+            case 'R': opts.max_reps = atoi(optarg); break;
+            case 't': opts.min_seconds = atof(optarg); break;
+            case 'o': out_path = optarg; break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (max_n < 1000 || max_n > 100000000 || opts.warmup < 0 ||
+        opts.min_reps < 1 || opts.max_reps < opts.min_reps) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if (out_path && !(out = fopen(out_path, "w"))) {
+        perror(out_path);
+        return 1;
+    }
+
+    int quantums[] = {2, 4, 8};
+    mlfq_config_t config = { 3, quantums, 50, NULL };
+
+    // Carga con utilización ~0.8: llegadas Poisson (0.1) y ráfagas
+    // exponenciales de media 8
+    gen_spec_t spec;
+    gen_spec_default(&spec);
+    spec.seed = 42;
+
+    fprintf(out, "{\n  \"warmup\": %d,\n  \"min_reps\": %d,\n  \"max_reps\": %d,\n"
+                 "  \"min_seconds\": %.3f,\n  \"workload\": \"poisson rate=%.2f, "
+                 "exponential mean=%.1f, seed=%llu\",\n  \"results\": [\n",
+            opts.warmup, opts.min_reps, opts.max_reps, opts.min_seconds,
+            spec.rate, spec.mean, (unsigned long long)spec.seed);
+
+    int first = 1;
+    for (long n = 1000; n <= max_n; n *= 10) {
+        proc_table_t pt;
+        char err[256];
+        spec.count = n;
+        if (generate_table(&spec, &pt, err, sizeof(err)) != 0) {
+            fprintf(stderr, "n=%ld: %s\n", n, err);
+            return 1;
+        }
+        bench_case_t c = { 0, &pt, &config, 0 };
+
+        for (int alg = 0; alg < SCHED_COUNT; alg++) {
+            char name[64];
+            snprintf(name, sizeof(name), "schedule_%s", sched_alg_name(alg));
+            for (char *p = name; *p; p++)
+                if (*p >= 'A' && *p <= 'Z') *p += 'a' - 'A';
+
+            bench_result_t r = { 0 };
+            r.name = name;
+            r.n = pt.n;
+            c.alg = alg;
+
+            // Una pasada sin cronometrar para contar eventos
+            timeline_sink_t sink = { count_event, NULL, &r.events };
+            if (schedule_run_table(alg, &pt, 3, &config, &sink) != 0) {
+                fprintf(stderr, "%s: out of memory at n=%ld\n", name, n);
+                return 1;
+            }
+
+            rss_reset_peak();
+            measure(&opts, case_schedule, &c, &r);
+            r.peak_rss_kb = rss_peak_kb();
+            print_result(out, &r, first);
+            first = 0;
+        }
+
+        // calculate_metrics sobre la última planificación (MLFQ)
+        c.makespan = proc_table_makespan(&pt);
+        bench_result_t r = { "calculate_metrics", pt.n, pt.n, 0, 0, 0, 0 };
+        rss_reset_peak();
+        measure(&opts, case_metrics, &c, &r);
+        r.peak_rss_kb = rss_peak_kb();
+        print_result(out, &r, 0);
+
+        proc_table_free(&pt);
+    }
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) fclose(out);
+    return 0;
+}
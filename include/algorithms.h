@@ -2,26 +2,45 @@
 #define ALGORITHMS_H
 
 #include "scheduler.h"
+#include "proctable.h"
+#include "timeline.h"
+#include "engine.h"
+#include "queue.h"
+#include "mlfq.h"
+
+// Todos los algoritmos añaden sus tramos de ejecución a `timeline`
+// (puede ser NULL si no se necesita el diagrama de Gantt).  Las variantes
+// *_stream entregan cada evento a un sink sin guardarlo, de modo que la
+// memoria no depende de la duración de la simulación.  Internamente los
+// motores trabajan sobre una proc_table_t (ver schedule_run_table).
 
 // -----------------------------
 // FIFO (First In First Out)
 // -----------------------------
-void schedule_fifo(process_t *processes, int n, timeline_event_t *timeline);
+void schedule_fifo(process_t *processes, int n, timeline_t *timeline);
+void schedule_fifo_stream(process_t *processes, int n,
+                          const timeline_sink_t *sink);
 
 // -----------------------------
 // SJF (Shortest Job First) - non-preemptive
 // -----------------------------
-void schedule_sjf(process_t *processes, int n, timeline_event_t *timeline);
+void schedule_sjf(process_t *processes, int n, timeline_t *timeline);
+void schedule_sjf_stream(process_t *processes, int n,
+                         const timeline_sink_t *sink);
 
 // -----------------------------
 // STCF (Shortest Time to Completion First) - preemptive SJF
 // -----------------------------
-void schedule_stcf(process_t *processes, int n, timeline_event_t *timeline);
+void schedule_stcf(process_t *processes, int n, timeline_t *timeline);
+void schedule_stcf_stream(process_t *processes, int n,
+                          const timeline_sink_t *sink);
 
 // -----------------------------
 // Round Robin
 // -----------------------------
-void schedule_rr(process_t *processes, int n, int quantum, timeline_event_t *timeline);
+void schedule_rr(process_t *processes, int n, int quantum, timeline_t *timeline);
+void schedule_rr_stream(process_t *processes, int n, int quantum,
+                        const timeline_sink_t *sink);
 
 // -----------------------------
 // MLFQ (Multi-Level Feedback Queue)
@@ -29,10 +48,205 @@ void schedule_rr(process_t *processes, int n, int quantum, timeline_event_t *tim
 typedef struct {
     int num_queues;
     int *quantums;          // Quantum por cada cola
-    int boost_interval;     // Tiempo de refuerzo (boost)
+    int boost_interval;     // Tiempo de refuerzo (boost); <= 0 lo desactiva
+    int *allotments;        // Tiempo total por nivel antes de degradar
+                            // (NULL = un quantum del nivel)
 } mlfq_config_t;
 
 void schedule_mlfq(process_t *processes, int n, mlfq_config_t *config,
-                   timeline_event_t *timeline);
+                   timeline_t *timeline);
+void schedule_mlfq_stream(process_t *processes, int n, mlfq_config_t *config,
+                          const timeline_sink_t *sink);
+
+// -----------------------------
+// Selección de algoritmo por identificador
+// -----------------------------
+typedef enum {
+    SCHED_FIFO = 0, SCHED_SJF, SCHED_STCF, SCHED_RR, SCHED_MLFQ, SCHED_COUNT
+} sched_alg_t;
+
+const char *sched_alg_name(sched_alg_t alg);
+
+/**
+ * Convierte un nombre ("fifo", "rr", ...) en identificador.
+ * @return Identificador, o -1 si el nombre no existe
+ */
+int sched_alg_parse(const char *name);
+
+/**
+ * Ejecuta `alg` sobre los procesos; quantum sólo se usa en RR y config
+ * sólo en MLFQ.
+ * @return 0 si todo fue bien, -1 si no hay memoria (los procesos no se
+ *         modifican)
+ */
+int schedule_run(sched_alg_t alg, process_t *processes, int n, int quantum,
+                 mlfq_config_t *config, const timeline_sink_t *sink);
+
+/**
+ * Igual sobre una tabla SoA, sin conversiones: sólo se escriben remaining,
+ * start y completion, así que la tabla se puede reutilizar para otro
+ * algoritmo sin restaurarla.
+ * @return 0 si todo fue bien, -1 si no hay memoria (los resultados de la
+ *         tabla no son válidos)
+ */
+int schedule_run_table(sched_alg_t alg, proc_table_t *pt, int quantum,
+                       mlfq_config_t *config, const timeline_sink_t *sink);
+
+/**
+ * Variantes con coste de cambio de contexto (ver switch_cost_t en
+ * scheduler.h); schedule_run y schedule_run_table equivalen a cost = NULL.
+ * Los cambios se cuentan aunque no cuesten nada.
+ * @param cost Coste de cada cambio (NULL = gratis)
+ * @param stats Cambios y tiempo perdido en ellos (puede ser NULL)
+ */
+int schedule_run_cost(sched_alg_t alg, process_t *processes, int n, int quantum,
+                      mlfq_config_t *config, const switch_cost_t *cost,
+                      const timeline_sink_t *sink, switch_stats_t *stats);
+int schedule_run_table_cost(sched_alg_t alg, proc_table_t *pt, int quantum,
+                            mlfq_config_t *config, const switch_cost_t *cost,
+                            const timeline_sink_t *sink, switch_stats_t *stats);
+
+// -----------------------------
+// Ejecución paso a paso
+// -----------------------------
+// sched_state_t guarda todo lo que un algoritmo necesita entre dos
+// decisiones: el motor (reloj, cursor de llegadas, procesos en E/S, stream
+// de la línea de tiempo) y su cola de listos.  Una decisión es un tramo o
+// un salto del reloj a la siguiente llegada.  Una simulación se puede
+// repartir en tantas llamadas como se quiera, p. ej. por rodajas de tiempo
+// real o desde otro hilo (nunca dos a la vez sobre el mismo estado):
+//
+//     sched_init(&st, SCHED_RR, &pt, 4, NULL, NULL, &sink);
+//     while (sched_step_events(&st, 100000) > 0)
+//         mostrar_progreso(st.sim.time, st.sim.completed, pt.n);
+//     sched_finish(&st, &stats);
+//
+// schedule_run_table_cost es exactamente eso sin límite de decisiones, y
+// cada algoritmo avanza en su propio bucle: repartir la simulación no la
+// hace más lenta.
+typedef struct {
+    sched_alg_t alg;
+    int quantum;                // RR; INT_MAX para FIFO con E/S
+    mlfq_config_t *config;      // MLFQ
+    int num_queues;             // MLFQ: niveles (al menos 1)
+    int fast;                   // FIFO sin E/S: procesos en orden de tabla,
+                                // sin cola de listos
+    int failed;                 // La cola de listos no pudo crecer: la
+                                // simulación se detuvo
+    int fifo_overhead;          // Coste de cada cambio en ese modo
+    sim_t sim;
+    heap_t heap;                // Listos de SJF y STCF
+    queue_t queue;              // Listos de RR y FIFO con E/S
+    mlfq_levels_t lv;           // Listos de MLFQ
+    long long next_boost;       // MLFQ: momento del próximo boost
+} sched_state_t;
+
+/**
+ * Prepara una ejecución de `alg` sobre la tabla (remaining = burst);
+ * los parámetros son los de schedule_run_table_cost.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int sched_init(sched_state_t *st, sched_alg_t alg, proc_table_t *pt, int quantum,
+               mlfq_config_t *config, const switch_cost_t *cost,
+               const timeline_sink_t *sink);
+
+/**
+ * Toma la siguiente decisión.
+ * @return 1 si avanzó, 0 si todos los procesos ya habían terminado, -1
+ *         si no hay memoria (la simulación no puede continuar)
+ */
+int sched_step(sched_state_t *st);
+
+/**
+ * Toma hasta k decisiones.
+ * @return Decisiones tomadas (< k sólo si la simulación terminó), o -1 si
+ *         no hay memoria
+ */
+long long sched_step_events(sched_state_t *st, long long k);
+
+/**
+ * Avanza mientras el reloj esté antes de t.  La última decisión empieza
+ * antes de t pero su tramo puede acabar después: al volver,
+ * st->sim.time >= t o la simulación terminó.
+ * @return 1 si quedan procesos por terminar, 0 si no, -1 si no hay memoria
+ */
+int sched_step_until(sched_state_t *st, long long t);
+
+/**
+ * Entrega ya al sink el evento que el stream retiene para fundirlo con el
+ * siguiente tramo, de modo que el sink ve todo lo ejecutado hasta ahora.
+ * Si el siguiente tramo lo continúa llegará como otro evento (un
+ * timeline_t los vuelve a fundir).
+ */
+void sched_flush(sched_state_t *st);
+
+static inline int sched_done(const sched_state_t *st) {
+    return st->sim.completed >= st->sim.n;
+}
+
+/**
+ * Procesos en la cola de listos y bloqueados en E/S ahora mismo.  FIFO
+ * sin E/S no tiene cola: cuenta los siguientes de la tabla que ya han
+ * llegado (exacto si la tabla está ordenada por llegada).
+ */
+int sched_ready(const sched_state_t *st);
+int sched_blocked(const sched_state_t *st);
+
+/**
+ * Entrega al sink el último evento y libera el estado; lo que no se haya
+ * simulado se descarta.
+ * @param stats Cambios de contexto hasta aquí (puede ser NULL)
+ * @return 0, o -1 si la simulación se detuvo por falta de memoria o el
+ *         sink perdió algún evento
+ */
+int sched_finish(sched_state_t *st, switch_stats_t *stats);
+
+// -----------------------------
+// Instantáneas
+// -----------------------------
+// Copia del estado entre dos pasos.  Sólo guarda los procesos activos
+// (admitidos y sin terminar): los terminados ya tienen start y completion
+// en la tabla y los que no han llegado están como los deja sched_init.
+typedef struct {
+    int idx;
+    int remaining;
+    int start;
+    int left;               // sim.left (con recarga parcial de caché)
+    int phase;              // sim.phase/wake (con E/S)
+    int wake;
+    mlfq_job_t mlfq;        // Nivel y cuota en MLFQ
+} sched_saved_job_t;
+
+typedef struct {
+    int time;
+    int next;               // Procesos admitidos (cursor de llegadas)
+    int completed;
+    int last;
+    switch_stats_t stats;
+    sim_totals_t totals;
+    long long next_boost;
+    int epoch;              // Boosts de MLFQ
+    int num_ready;          // job[0..num_ready): cola de listos en orden;
+    int num_active;         // el resto, bloqueados en E/S
+    sched_saved_job_t *job;
+    int *level_count;       // MLFQ: listos de cada nivel, en job[] por nivel
+} sched_snapshot_t;
+
+/**
+ * Guarda el estado actual; cuesta O(procesos activos).
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int sched_save(const sched_state_t *st, sched_snapshot_t *snap);
+
+/**
+ * Continúa desde una instantánea.  st viene de sched_init con el mismo
+ * algoritmo y parámetros sobre una tabla cuyos snap->next primeros
+ * procesos por orden de llegada son los mismos, en los mismos índices, y
+ * conservan start y completion de la ejecución guardada; el resto de la
+ * tabla puede haber cambiado.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int sched_restore(sched_state_t *st, const sched_snapshot_t *snap);
+void sched_snapshot_free(sched_snapshot_t *snap);
 
 #endif // ALGORITHMS_H
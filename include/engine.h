@@ -0,0 +1,123 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "scheduler.h"
+#include "proctable.h"
+#include "timeline.h"
+#include "heap.h"
+
+// -----------------------------
+// Motor de simulación por eventos discretos
+// -----------------------------
+// El reloj nunca avanza de unidad en unidad: salta directamente a la
+// siguiente llegada, finalización o fin de quantum. Las llegadas se
+// recorren con un cursor sobre los procesos ordenados por arrival_time.
+// Trabaja sobre la tabla SoA: sólo escribe remaining, start y completion.
+//
+// Con un switch_cost_t cada cambio de proceso adelanta el reloj antes del
+// tramo; los motores deciden el tramo antes de pagarlo, así que una
+// expulsión puede llegar un cambio más tarde que sin coste.
+//
+// Con ráfagas de E/S (pt->first) remaining es la ráfaga de CPU en curso.
+// Al agotarla el proceso se bloquea durante la E/S siguiente y vuelve a
+// salir de sim_admit_next al terminarla, igual que una llegada: los
+// motores no distinguen E/S salvo para conservar estado (sim_woke).
+
+// Sumas de lo simulado hasta ahora: bastan para mostrar métricas parciales
+// durante una ejecución sin recorrer la tabla
+typedef struct {
+    long long busy;         // Tiempo ejecutado (sin contar los cambios)
+    long long response;     // Suma de start - arrival de los que empezaron
+    long long turnaround;   // Suma de completion - arrival de los terminados
+    int started;            // Procesos que ya se ejecutaron alguna vez
+} sim_totals_t;
+
+typedef struct {
+    proc_table_t *pt;       // Procesos (se modifican en sitio)
+    int n;                  // Número de procesos
+    int *order;             // Índices ordenados por (arrival, índice);
+                            // NULL si la tabla ya venía ordenada
+    int next;               // Cursor: primer índice de order[] no admitido
+    int time;               // Reloj de simulación
+    int completed;          // Procesos terminados
+    timeline_stream_t out;  // Tramos ejecutados, fusionados hacia el sink
+    switch_cost_t cost;     // Todo a 0 si no hay coste
+    int *left;              // Momento en que cada proceso dejó la CPU; sólo
+                            // con recarga de caché parcial (cache_decay > 0)
+    int last;               // Último proceso ejecutado (-1 = ninguno)
+    switch_stats_t stats;   // Cambios y overhead acumulados
+    sim_totals_t totals;
+    int *phase;             // Ráfaga de CPU en curso (posición en
+                            // pt->bursts); NULL sin E/S
+    int *wake;              // Fin de la E/S de cada proceso bloqueado
+    heap_t blocked;         // Procesos en E/S por (wake, índice)
+} sim_t;
+
+/**
+ * Prepara la simulación: remaining = burst y orden por llegada.
+ * @param cost Coste de los cambios de contexto (NULL = sin coste)
+ * @param sink Destino de los eventos de la línea de tiempo (puede ser NULL)
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int sim_init(sim_t *sim, proc_table_t *pt, const switch_cost_t *cost,
+             const timeline_sink_t *sink);
+
+/**
+ * Entrega al sink el último evento pendiente y libera la simulación.
+ * @return 0, o -1 si el sink perdió algún evento (ver stream_end)
+ */
+int sim_free(sim_t *sim);
+
+/**
+ * Admite el siguiente proceso con arrival_time <= time; antes que las
+ * llegadas, los que terminaron su E/S.
+ * @return Índice del proceso admitido, o -1 si no queda ninguno
+ */
+int sim_admit_next(sim_t *sim);
+
+/**
+ * Tiempo de la siguiente llegada o fin de E/S pendiente, o INT_MAX si no
+ * quedan.
+ */
+int sim_next_arrival(const sim_t *sim);
+
+/**
+ * Tiempo de la siguiente llegada de un proceso nuevo (sin contar los
+ * fines de E/S), o INT_MAX si no quedan.
+ */
+int sim_next_new(const sim_t *sim);
+
+/**
+ * Tiempo del siguiente fin de E/S, o INT_MAX si no hay procesos
+ * bloqueados.
+ */
+int sim_next_wake(const sim_t *sim);
+
+/**
+ * 1 si idx ya ejecutó alguna ráfaga de CPU (vuelve de E/S) en lugar de
+ * llegar por primera vez.
+ */
+static inline int sim_woke(const sim_t *sim, int idx) {
+    return sim->phase && sim->phase[idx] > sim->pt->first[idx];
+}
+
+/**
+ * Ejecuta el proceso idx durante `duration` unidades a partir de time,
+ * entrega el tramo al sink y lo da por terminado si
+ * remaining llega a 0.  Si idx no es el último proceso ejecutado, antes
+ * se paga el cambio de contexto (el tramo empieza tras él).
+ */
+void sim_run(sim_t *sim, int idx, int duration);
+
+/**
+ * Coste de pasar a un proceso que lleva `off` unidades fuera de la CPU
+ * (never_ran = 1 si aún no se ha ejecutado: caché fría).
+ */
+static inline int switch_overhead(const switch_cost_t *cost, int never_ran, int off) {
+    int penalty = cost->cache_penalty;
+    if (!never_ran && cost->cache_decay > 0 && off < cost->cache_decay)
+        penalty = (int)((long long)penalty * off / cost->cache_decay);
+    return cost->switch_time + penalty;
+}
+
+#endif // ENGINE_H
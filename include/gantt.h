@@ -0,0 +1,66 @@
+#ifndef GANTT_H
+#define GANTT_H
+
+#include "timeline.h"
+
+// -----------------------------
+// Índice de intervalos para dibujar diagramas de Gantt
+// -----------------------------
+// Una columna de pantalla cubre un intervalo de tiempo que puede contener
+// millones de tramos.  El índice resume la línea de tiempo (una sola CPU,
+// eventos ordenados) en una pirámide: el nivel 0 tiene un nodo por cada
+// GANTT_BLOCK eventos y cada nivel siguiente junta dos nodos del anterior.
+// Cada nodo guarda el tiempo ejecutado y el tramo más largo, así que una
+// columna se resume en O(log n + GANTT_BLOCK) sin mirar todos sus tramos:
+// dibujar cualquier vista cuesta lo que el ancho de la pantalla.
+//
+// El índice sigue a la línea de tiempo mientras crece: el último evento
+// aún puede alargarse (timeline_append_event funde los tramos seguidos),
+// así que sólo se resumen los anteriores y el resto se recorre al
+// consultar.
+#define GANTT_BLOCK 16
+#define GANTT_LEVELS 32
+
+typedef struct {
+    long long busy;         // Tiempo ejecutado en los eventos del nodo
+    int longest;            // Duración del tramo más largo
+    int first;              // Índice de ese tramo (el primero si empatan)
+} gantt_node_t;
+
+typedef struct {
+    gantt_node_t *level[GANTT_LEVELS];
+    int capacity[GANTT_LEVELS];
+    int indexed;            // Eventos resumidos: múltiplo de GANTT_BLOCK
+} gantt_index_t;
+
+// Resumen de un intervalo [from, to)
+typedef struct {
+    int pid;                // Dueño del tramo más largo (-1 = CPU ociosa)
+    long long busy;         // Tiempo ejecutado dentro del intervalo
+} gantt_column_t;
+
+void gantt_index_init(gantt_index_t *gi);
+void gantt_index_free(gantt_index_t *gi);
+
+/**
+ * Resume los eventos que tl ha ganado desde la última llamada; cuesta
+ * O(1) amortizado por evento.
+ * @return 0 si todo fue bien, -1 si no hay memoria (el índice sigue
+ *         siendo válido para lo ya resumido)
+ */
+int gantt_index_update(gantt_index_t *gi, const timeline_t *tl);
+
+/**
+ * Olvida lo resumido a partir del evento `count`: hay que llamarla si tl
+ * se recorta o se vacía (timeline_truncate, timeline_clear).
+ */
+void gantt_index_truncate(gantt_index_t *gi, int count);
+
+/**
+ * Tramo más largo y tiempo ejecutado en [from, to), recortando los tramos
+ * de los bordes.
+ */
+gantt_column_t gantt_query(const gantt_index_t *gi, const timeline_t *tl,
+                           long long from, long long to);
+
+#endif // GANTT_H
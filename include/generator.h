@@ -0,0 +1,135 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <stdint.h>
+#include "workload.h"
+#include "proctable.h"
+
+// -----------------------------
+// PRNG xoshiro256** (semilla expandida con splitmix64)
+// -----------------------------
+typedef struct {
+    uint64_t s[4];
+} rng_t;
+
+void rng_seed(rng_t *rng, uint64_t seed);
+uint64_t rng_next(rng_t *rng);
+
+/**
+ * Uniforme en (0, 1]; nunca devuelve 0, así que log(u) es finito.
+ */
+double rng_uniform(rng_t *rng);
+
+/**
+ * Exponencial de media `mean`.
+ */
+double rng_exponential(rng_t *rng, double mean);
+
+// -----------------------------
+// Especificación de la carga sintética
+// -----------------------------
+typedef enum { ARRIVAL_POISSON = 0, ARRIVAL_MMPP } arrival_dist_t;
+typedef enum { BURST_EXPONENTIAL = 0, BURST_BIMODAL, BURST_PARETO } burst_dist_t;
+
+#define GEN_MAX_PRIORITIES 16
+#define GEN_MAX_BURSTS 127          // Ráfagas de un proceso con E/S (CPU y E/S)
+
+typedef struct {
+    uint64_t seed;
+    long long count;            // Procesos a generar
+
+    arrival_dist_t arrival;
+    double rate;                // Llegadas por unidad de tiempo (estado normal)
+    double burst_rate;          // MMPP: tasa durante una ráfaga
+    double mean_off;            // MMPP: duración media del estado normal
+    double mean_on;             // MMPP: duración media de la ráfaga
+
+    burst_dist_t burst;
+    double mean;                // Exponencial: media
+    double short_mean;          // Bimodal: media de los trabajos cortos
+    double long_mean;           // Bimodal: media de los trabajos largos
+    double long_fraction;       // Bimodal: fracción de trabajos largos
+    double alpha;               // Pareto: forma
+    double min;                 // Pareto: valor mínimo
+
+    int num_priorities;         // Prioridades 0..num_priorities-1
+    double priority_weights[GEN_MAX_PRIORITIES];    // Peso de cada una
+
+    // Procesos interactivos: su CPU total se reparte en ráfagas
+    // exponenciales separadas por E/S (la última se lleva el resto si se
+    // llega a GEN_MAX_BURSTS)
+    double io_fraction;         // Fracción de procesos con E/S (0 = ninguno)
+    double io_cpu;              // Media de cada ráfaga de CPU
+    double io_wait;             // Media de cada ráfaga de E/S
+} gen_spec_t;
+
+/**
+ * Rellena la especificación con valores por defecto: 1000 procesos,
+ * Poisson con tasa 0.1, ráfagas exponenciales de media 8, 4 prioridades
+ * equiprobables, sin E/S (con io > 0: ráfagas de CPU de media 2 y de E/S
+ * de media 20).
+ */
+void gen_spec_default(gen_spec_t *spec);
+
+/**
+ * Aplica pares "clave=valor" separados por comas sobre spec, p. ej.
+ * "n=1000000,seed=7,arrival=mmpp,rate=0.05,burst_rate=1,burst=pareto,alpha=1.5,prio=6:3:1".
+ * io=F, io_cpu=M e io_wait=M configuran los procesos con E/S.
+ * @return 0 si todo fue bien, -1 con el motivo en err
+ */
+int gen_spec_parse(gen_spec_t *spec, const char *text, char *err, size_t errlen);
+
+// -----------------------------
+// Generador en streaming
+// -----------------------------
+typedef struct {
+    gen_spec_t spec;
+    rng_t rng;
+    double clock;               // Tiempo continuo de la última llegada
+    int mmpp_on;                // MMPP: 1 durante una ráfaga
+    double state_end;           // MMPP: fin del estado actual
+    double priority_cdf[GEN_MAX_PRIORITIES];
+    long long produced;
+} generator_t;
+
+void gen_init(generator_t *g, const gen_spec_t *spec);
+
+/**
+ * Produce el siguiente proceso (pids consecutivos desde 1, llegadas no
+ * decrecientes).
+ * @return 0, 1 si ya se generaron spec.count procesos, o -1 si el proceso
+ *         terminaría después de INT_MAX (la carga no cabe en tiempos int)
+ */
+int gen_next(generator_t *g, workload_record_t *rec);
+
+/**
+ * Igual con las ráfagas: en un proceso con E/S rec->burst_time es el total
+ * de CPU y bursts recibe CPU, E/S, ..., CPU (*num_bursts impar); sin E/S
+ * *num_bursts = 1.  La secuencia aleatoria es la misma que con gen_next.
+ * @param bursts Espacio para GEN_MAX_BURSTS ráfagas
+ */
+int gen_next_bursts(generator_t *g, workload_record_t *rec, int *bursts,
+                    int *num_bursts);
+
+/**
+ * Genera toda la carga en memoria.
+ * @return 0 si todo fue bien, -1 con el motivo en err (sin memoria o
+ *         tiempos fuera de rango)
+ */
+int generate_workload(const gen_spec_t *spec, workload_t *wl, char *err, size_t errlen);
+
+/**
+ * Genera toda la carga en una tabla SoA nueva (28 bytes por proceso).
+ * @return 0 si todo fue bien, -1 con el motivo en err
+ */
+int generate_table(const gen_spec_t *spec, proc_table_t *pt, char *err, size_t errlen);
+
+/**
+ * Genera la carga directamente a archivo sin guardarla en memoria.  Si los
+ * tiempos se salen de rango se borra el archivo.
+ * @return 0 si todo fue bien, -1 con el motivo en err
+ */
+int generate_to_file(const gen_spec_t *spec, const char *filename, int binary,
+                     char *err, size_t errlen);
+
+#endif // GENERATOR_H
@@ -0,0 +1,72 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdint.h>
+
+// -----------------------------
+// Cola de listos: min-heap indexado
+// -----------------------------
+// Ordena procesos por (key, tie); key suele ser burst_time o
+// remaining_time y tie el pid, de modo que el orden es determinista.
+// pos[] permite localizar un proceso en O(1) y cambiar su clave en
+// O(log n).
+//
+// (key, tie) se empaqueta en un int64 para comparar de una vez.  Mientras
+// hay pocos elementos (<= HEAP_FLAT_MAX) no se mantiene el orden de heap:
+// se guarda la posición del mínimo, insertar y reducir claves es O(1) y
+// sólo al extraerlo (o al subir su clave) se busca otro con
+// simd_argmin_i64.  Al crecer se reordena como heap (Floyd, O(n)) y vuelve
+// al modo plano cuando baja a la mitad del umbral.
+#define HEAP_FLAT_MAX 16
+
+typedef struct {
+    int64_t *keys;      // (key << 32) | tie con el signo invertido
+    int *idx;           // Índice del proceso en el arreglo de entrada
+    int *pos;           // pos[idx] = posición en keys, o -1 si no está
+    int size;
+    int capacity;       // Número de índices posibles (0..capacity-1)
+    int slots;          // Entradas reservadas en keys/idx
+    int shared_pos;     // 1 si pos pertenece a quien llamó a heap_init_shared
+    int heapified;      // 1 si keys[0..size) cumple el orden de heap
+    int top;            // Posición del mínimo (siempre 0 con heapified)
+} heap_t;
+
+/**
+ * Reserva un heap para índices 0..capacity-1.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int heap_init(heap_t *h, int capacity);
+
+/**
+ * Heap que usa un pos[] ajeno (capacity elementos, inicializados a -1) y
+ * cuyas entradas crecen al insertar.  Varios heaps pueden compartir pos si
+ * un índice nunca está en dos a la vez, p. ej. una cola por CPU.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int heap_init_shared(heap_t *h, int *pos, int capacity);
+void heap_free(heap_t *h);
+
+/**
+ * @return 0 si todo fue bien, -1 si un heap compartido no pudo crecer
+ */
+int heap_push(heap_t *h, int idx, int key, int tie);
+
+/**
+ * Extrae el índice de menor (key, tie), o -1 si el heap está vacío.
+ */
+int heap_pop(heap_t *h);
+
+/**
+ * Índice de menor (key, tie) sin extraerlo, o -1 si está vacío.
+ */
+int heap_peek(const heap_t *h);
+
+/**
+ * Cambia la clave de un índice que ya está en el heap.
+ */
+void heap_update(heap_t *h, int idx, int key);
+
+static inline int heap_empty(const heap_t *h) { return h->size == 0; }
+static inline int heap_size(const heap_t *h) { return h->size; }
+
+#endif // HEAP_H
@@ -0,0 +1,60 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+// -----------------------------
+// Histograma logarítmico (estilo HDR)
+// -----------------------------
+// Valores 0..127 se guardan exactos; por encima, cada potencia de 2 se
+// divide en 64 cubetas, así que el error relativo es < 1/64 (1.6 %).
+// El tamaño es fijo (≈13 KB) sin importar cuántos valores se registren,
+// y dos histogramas se combinan sumando cubetas.
+#define HIST_SUB_BUCKETS 64
+#define HIST_BUCKETS     (2 * HIST_SUB_BUCKETS + 24 * HIST_SUB_BUCKETS)
+
+typedef struct {
+    long long counts[HIST_BUCKETS];
+    long long total;        // Valores registrados
+    int min;
+    int max;
+} hist_t;
+
+void hist_init(hist_t *h);
+
+/**
+ * Cubeta de un valor >= 0, sin saltos: shift = max(0, msb - 6) y la
+ * cubeta es (shift << 6) + (v >> shift), que para v < 128 es v.
+ */
+static inline int hist_bucket(int v) {
+    int shift = 25 - __builtin_clz((unsigned)v | 1);
+    shift = shift < 0 ? 0 : shift;
+    return (shift << 6) + (v >> shift);
+}
+
+/**
+ * Registra un valor (los negativos cuentan como 0).
+ */
+void hist_record(hist_t *h, int value);
+
+/**
+ * Registra n valores de los que ya se calculó la cubeta (hist_bucket),
+ * p. ej. con un núcleo vectorial.  Sólo actualiza cuentas y total: el
+ * mínimo y el máximo se añaden con hist_add_range.
+ */
+void hist_record_buckets(hist_t *h, const int *buckets, int n);
+void hist_add_range(hist_t *h, int min, int max);
+
+/**
+ * Acumula src en dst (p. ej. para combinar varias ejecuciones).
+ */
+void hist_merge(hist_t *dst, const hist_t *src);
+
+/**
+ * Valor por debajo del cual queda el q % de las muestras.
+ * @param q Percentil en [0, 100]
+ * @return Límite superior de la cubeta correspondiente, o 0 si está vacío
+ */
+int hist_percentile(const hist_t *h, double q);
+
+static inline int hist_max(const hist_t *h) { return h->total ? h->max : 0; }
+
+#endif // HISTOGRAM_H
@@ -2,16 +2,42 @@
 #define METRICS_H
 
 #include "scheduler.h"
+#include "proctable.h"
+#include "histogram.h"
+
+// Resumen de la cola de latencias de una magnitud
+typedef struct {
+    int p50;
+    int p95;
+    int p99;
+    int p999;
+    int max;
+} latency_summary_t;
 
 typedef struct {
     double avg_turnaround_time;
     double avg_waiting_time;
     double avg_response_time;
-    double cpu_utilization;
+    double cpu_utilization;         // Media de todas las CPUs
     double throughput;
     double fairness_index;   // Jain’s fairness index
+    latency_summary_t turnaround;   // Percentiles (error relativo < 1/64)
+    latency_summary_t waiting;
+    latency_summary_t response;
+    int num_cpus;                   // CPUs simuladas (1 salvo en modo SMP)
+    long long migrations;           // Cambios de CPU de un proceso (SMP)
+    long long context_switches;     // Cambios de proceso en las CPUs
+    long long switch_overhead;      // Tiempo perdido en ellos
+    double effective_utilization;   // Utilización sin contar el overhead
 } metrics_t;
 
+// Histogramas de latencia que se pueden acumular entre ejecuciones
+typedef struct {
+    hist_t turnaround;
+    hist_t waiting;
+    hist_t response;
+} latency_hist_t;
+
 /**
  * Calcula métricas de rendimiento del planificador.
  * @param processes Lista de procesos
@@ -22,4 +48,40 @@ typedef struct {
 void calculate_metrics(process_t *processes, int n, int total_time,
                        metrics_t *metrics);
 
+/**
+ * Igual sobre una tabla SoA ya planificada; sólo lee arrival, burst,
+ * start y completion.
+ */
+void calculate_metrics_table(const proc_table_t *pt, int total_time,
+                             metrics_t *metrics);
+
+/**
+ * Igual con num_cpus CPUs: la utilización es el tiempo ocupado entre
+ * num_cpus * total_time.  migrations queda a 0 (lo rellena smp_metrics).
+ */
+void calculate_metrics_table_cpus(const proc_table_t *pt, int total_time,
+                                  int num_cpus, metrics_t *metrics);
+
+/**
+ * Añade los cambios de contexto de la ejecución: el overhead cuenta como
+ * tiempo ocupado en cpu_utilization pero no en effective_utilization.
+ */
+void metrics_add_switches(metrics_t *metrics, const switch_stats_t *stats,
+                          int total_time);
+
+void latency_hist_init(latency_hist_t *lh);
+
+/**
+ * Registra turnaround, waiting y response de procesos ya planificados.
+ */
+void latency_hist_record(latency_hist_t *lh, const process_t *processes, int n);
+void latency_hist_record_table(latency_hist_t *lh, const proc_table_t *pt);
+
+void latency_hist_merge(latency_hist_t *dst, const latency_hist_t *src);
+
+/**
+ * Calcula p50/p95/p99/p99.9 y máximo de un histograma.
+ */
+void latency_summarize(const hist_t *h, latency_summary_t *out);
+
 #endif // METRICS_H
@@ -0,0 +1,100 @@
+#ifndef MLFQ_H
+#define MLFQ_H
+
+// -----------------------------
+// Colas por nivel de MLFQ
+// -----------------------------
+// Nivel 0 = mayor prioridad.  Cada nivel es una lista FIFO enlazada a
+// través de los propios procesos (job[i].next), así que un boost concatena
+// todas las listas en O(niveles).  Un bit por nivel indica si su cola
+// tiene procesos y elegir el siguiente nivel cuesta O(niveles / 64).
+//
+// Varias colas pueden compartir el arreglo job (una por CPU) porque un
+// proceso sólo está en una a la vez; en ese caso todas deben hacer los
+// boosts a la vez para que sus epoch coincidan.
+typedef struct {
+    int next;       // Siguiente proceso en la misma cola (-1 = último)
+    int level;
+    int used;       // Tiempo consumido en su nivel
+    int epoch;      // Boost en el que se fijaron level/used
+} mlfq_job_t;
+
+typedef struct {
+    int *head;
+    int *tail;
+    unsigned long long *bitmap;
+    int words;
+    int num_queues;
+    int count;          // Procesos en todas las colas
+    mlfq_job_t *job;
+    int shared_job;     // 1 si job pertenece a otra cola
+    int epoch;          // Número de boosts realizados
+} mlfq_levels_t;
+
+/**
+ * Reserva num_queues niveles y, si job es NULL, el estado de n procesos.
+ * @return 0 si todo fue bien, -1 si no hay memoria (liberar igualmente)
+ */
+int mlfq_levels_init(mlfq_levels_t *lv, int num_queues, int n, mlfq_job_t *job);
+void mlfq_levels_free(mlfq_levels_t *lv);
+
+/**
+ * Encadena todas las colas, en orden de nivel, tras el nivel 0; los
+ * procesos recuperan su cuota al salir (epoch).
+ */
+void mlfq_boost(mlfq_levels_t *lv);
+
+static inline void mlfq_push(mlfq_levels_t *lv, int level, int idx) {
+    lv->job[idx].next = -1;
+    if (lv->tail[level] < 0)
+        lv->head[level] = idx;
+    else
+        lv->job[lv->tail[level]].next = idx;
+    lv->tail[level] = idx;
+    lv->bitmap[level / 64] |= 1ULL << (level % 64);
+    lv->count++;
+}
+
+static inline int mlfq_pop(mlfq_levels_t *lv, int level) {
+    int idx = lv->head[level];
+    lv->head[level] = lv->job[idx].next;
+    if (lv->head[level] < 0) {
+        lv->tail[level] = -1;
+        lv->bitmap[level / 64] &= ~(1ULL << (level % 64));
+    }
+    lv->count--;
+
+    // Tras un boost el proceso vuelve a empezar con la cuota intacta
+    mlfq_job_t *j = &lv->job[idx];
+    if (j->epoch != lv->epoch) {
+        j->used = 0;
+        j->epoch = lv->epoch;
+    }
+    j->level = level;
+    return idx;
+}
+
+// Un proceso nuevo entra al nivel 0 con la cuota intacta
+static inline void mlfq_admit(mlfq_levels_t *lv, int idx) {
+    lv->job[idx].level = 0;
+    lv->job[idx].used = 0;
+    lv->job[idx].epoch = lv->epoch;
+    mlfq_push(lv, 0, idx);
+}
+
+// Un proceso que vuelve de E/S conserva su nivel y la cuota gastada, salvo
+// que haya habido un boost mientras estaba bloqueado
+static inline void mlfq_wake(mlfq_levels_t *lv, int idx) {
+    const mlfq_job_t *j = &lv->job[idx];
+    mlfq_push(lv, j->epoch == lv->epoch ? j->level : 0, idx);
+}
+
+// Nivel no vacío de mayor prioridad, o -1 si todas las colas están vacías
+static inline int mlfq_top_level(const mlfq_levels_t *lv) {
+    for (int w = 0; w < lv->words; w++)
+        if (lv->bitmap[w])
+            return w * 64 + __builtin_ctzll(lv->bitmap[w]);
+    return -1;
+}
+
+#endif // MLFQ_H
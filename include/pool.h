@@ -0,0 +1,74 @@
+#ifndef POOL_H
+#define POOL_H
+
+// -----------------------------
+// Ejecución paralela de tareas independientes
+// -----------------------------
+// Reparte las tareas 0..num_tasks-1 entre num_threads hilos POSIX y
+// espera a que terminen todas.  Cada hilo empieza con un tramo contiguo y,
+// al agotarlo, roba la mitad del tramo pendiente de otro, de modo que las
+// tareas de coste desigual se equilibran solas.  `worker` (0..num_threads-1) identifica al
+// hilo, para que cada uno use su propia memoria de trabajo.
+typedef void (*pool_task_fn)(void *ctx, int task, int worker);
+
+/**
+ * Número de CPUs en línea (al menos 1).
+ */
+int pool_default_threads(void);
+
+/**
+ * @param num_threads Hilos a usar (<= 0 = pool_default_threads())
+ * @return 0 si todo fue bien, -1 si no hay memoria (no se ejecuta nada)
+ */
+int pool_run(int num_tasks, int num_threads, pool_task_fn fn, void *ctx);
+
+// -----------------------------
+// Hilos que avanzan a la vez
+// -----------------------------
+// Para simulaciones que se sincronizan por fases: todos los hilos ejecutan
+// fn a la vez y se esperan en una barrera sin cerrojos (espera activa que
+// cede el núcleo si se alarga).
+typedef struct {
+    int count;
+    int sense;
+    int threads;
+} pool_barrier_t;
+
+typedef void (*pool_worker_fn)(void *ctx, int worker, int num_workers);
+
+void pool_barrier_init(pool_barrier_t *b, int threads);
+
+/**
+ * Espera a que lleguen los `threads` hilos.  `sense` es del hilo y empieza
+ * a 0.
+ */
+void pool_barrier_wait(pool_barrier_t *b, int *sense);
+
+/**
+ * Ejecuta fn(ctx, w, num_workers) en num_workers hilos a la vez (el
+ * llamante es el 0).  Si no se pueden crear todos, fn se ejecuta sólo en
+ * el llamante con num_workers = 1.
+ * @return Número de hilos que ejecutaron fn
+ */
+int pool_spawn(int num_threads, pool_worker_fn fn, void *ctx);
+
+// -----------------------------
+// Hilo en segundo plano
+// -----------------------------
+// Un hilo que corre fn(ctx) mientras el llamante sigue a lo suyo (p. ej.
+// una simulación larga mientras la interfaz se redibuja).  pthread.h no
+// sale de pool.c: trae <sched.h>, cuyos SCHED_FIFO/SCHED_RR chocan con
+// sched_alg_t.
+typedef struct pool_thread pool_thread_t;
+
+/**
+ * @return Hilo arrancado, o NULL si no se pudo crear (fn no se ejecuta)
+ */
+pool_thread_t *pool_thread_start(void (*fn)(void *ctx), void *ctx);
+
+/**
+ * Espera a que fn termine y libera el hilo.
+ */
+void pool_thread_join(pool_thread_t *t);
+
+#endif // POOL_H
@@ -0,0 +1,111 @@
+#ifndef PROCTABLE_H
+#define PROCTABLE_H
+
+#include <stddef.h>
+#include "scheduler.h"
+#include "workload.h"
+
+// -----------------------------
+// Tabla de procesos en formato SoA (structure of arrays)
+// -----------------------------
+// Los bucles de selección sólo leen llegada, ráfaga y tiempo restante, así
+// que esos campos van en arrays propios (calientes) y cada decisión trae a
+// caché 4 bytes por campo en lugar del process_t entero de 56 bytes.  Los
+// resultados derivados (turnaround, waiting, response) no se guardan: se
+// calculan al convertir a process_t o en calculate_metrics_table.
+//
+// Los motores no modifican arrival/burst/pid/priority, así que la misma
+// tabla se puede planificar varias veces sin copiarla.
+//
+// Las ráfagas de E/S van aparte, en formato CSR, y sólo existen si algún
+// proceso tiene E/S; con ellas remaining es lo que queda de la ráfaga de
+// CPU en curso.
+typedef struct {
+    int n;
+    // Calientes
+    int *arrival;           // Tiempo de llegada
+    int *burst;             // Tiempo total de CPU
+    int *remaining;         // Tiempo restante (lo inicializan los motores)
+    // Fríos
+    int *pid;
+    int *priority;
+    int *start;             // Primer momento en que fue planificado
+    int *completion;        // Momento en que finalizó
+    int *block;             // Reserva única de la que salen los arrays
+    // Ráfagas de E/S (NULL si ningún proceso tiene E/S)
+    int *first;             // n + 1 posiciones: las ráfagas de i son
+                            // bursts[first[i]..first[i + 1]); ninguna = una
+                            // sola ráfaga de CPU de burst[i]
+    int *bursts;            // CPU, E/S, ..., CPU de los procesos con E/S
+    int *io;                // E/S total de cada proceso
+    int *io_block;          // Reserva de first/bursts/io (NULL si es ajena)
+} proc_table_t;
+
+/**
+ * Reserva una tabla para n procesos (28 bytes por proceso).
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int proc_table_init(proc_table_t *t, int n);
+void proc_table_free(proc_table_t *t);
+
+/**
+ * Reserva las ráfagas de E/S de una tabla ya reservada: first, io y
+ * num_bursts entradas de bursts.  Quien llama las rellena.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int proc_table_init_io(proc_table_t *t, size_t num_bursts);
+
+/**
+ * Tabla de trabajo que comparte (sin copiar) arrival, burst, pid,
+ * priority y las ráfagas de E/S con src y sólo reserva remaining, start y
+ * completion (12 bytes por proceso).  src debe vivir más que t.
+ */
+int proc_table_init_shared(proc_table_t *t, const proc_table_t *src);
+
+/**
+ * Reserva la tabla y copia los campos de entrada de processes.
+ */
+int proc_table_from_processes(proc_table_t *t, const process_t *processes, int n);
+
+/**
+ * Igual, a partir de registros binarios (p. ej. una vista mapeada).
+ */
+int proc_table_from_records(proc_table_t *t, const workload_record_t *records,
+                            size_t count);
+
+/**
+ * Igual a partir de una vista mapeada, con su sección de ráfagas si la
+ * tiene (versión 2).
+ */
+int proc_table_from_view(proc_table_t *t, const workload_view_t *view);
+
+/**
+ * Carga un archivo de carga (texto o binario, como workload_load) en la
+ * tabla.  El binario se mapea y se convierte sin pasar por process_t.
+ * @return 0 si todo fue bien, -1 con el motivo en err
+ */
+int proc_table_load(const char *filename, proc_table_t *t, char *err, size_t errlen);
+
+/**
+ * Escribe todos los campos de process_t, incluidos los derivados, para
+ * los t->n procesos; num_bursts y bursts no se tocan (siguen apuntando a
+ * la carga original).
+ */
+void proc_table_to_processes(const proc_table_t *t, process_t *processes);
+
+/**
+ * Inserta p en la posición pos (0..n) con remaining = burst y start y
+ * completion a 0, o quita el proceso pos; los demás conservan todos sus
+ * campos.  La tabla (propia, no de proc_table_init_shared) se vuelve a
+ * reservar: cuesta O(n).
+ * @return 0 si todo fue bien, -1 si no hay memoria (la tabla no cambia)
+ */
+int proc_table_insert(proc_table_t *t, int pos, const process_t *p);
+int proc_table_remove(proc_table_t *t, int pos);
+
+/**
+ * Mayor completion de la tabla (0 si está vacía).
+ */
+int proc_table_makespan(const proc_table_t *t);
+
+#endif // PROCTABLE_H
@@ -0,0 +1,35 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+// -----------------------------
+// Cola FIFO circular de índices de proceso
+// -----------------------------
+// Buffer circular que duplica su capacidad cuando se llena; push y pop
+// cuestan O(1) amortizado.
+typedef struct {
+    int *buf;
+    int head;       // Posición del primer elemento
+    int count;      // Elementos en la cola
+    int capacity;
+} queue_t;
+
+/**
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int queue_init(queue_t *q, int capacity);
+void queue_free(queue_t *q);
+
+/**
+ * Añade idx al final de la cola.
+ * @return 0 si todo fue bien, -1 si no hay memoria para crecer
+ */
+int queue_push(queue_t *q, int idx);
+
+/**
+ * Extrae el primer elemento, o -1 si la cola está vacía.
+ */
+int queue_pop(queue_t *q);
+
+static inline int queue_empty(const queue_t *q) { return q->count == 0; }
+
+#endif // QUEUE_H
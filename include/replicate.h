@@ -0,0 +1,60 @@
+#ifndef REPLICATE_H
+#define REPLICATE_H
+
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "generator.h"
+
+// -----------------------------
+// Réplicas Monte Carlo
+// -----------------------------
+// K cargas independientes generadas a partir de la misma especificación
+// (sólo cambia la semilla), cada una simulada con los algoritmos elegidos.
+
+// Métricas de metrics_t que se agregan: 6 medias/ratios, 3 de cambios de
+// contexto y 3 x 5 percentiles
+#define REP_METRICS 24
+
+typedef struct {
+    double mean;
+    double stddev;          // Desviación típica muestral (n - 1)
+    double ci_lo;           // Intervalo de confianza del 95% de la media
+    double ci_hi;
+} rep_stat_t;
+
+/**
+ * Semilla de la réplica r: se sacan en orden de un xoshiro256** sembrado
+ * con spec->seed, así que no dependen del número de hilos.
+ */
+void replicate_seeds(uint64_t seed, int k, uint64_t *seeds);
+
+/**
+ * Genera y simula k réplicas repartidas entre num_threads hilos (<= 0 =
+ * todos los núcleos).  Cada hilo tiene su propio generador y memoria de
+ * trabajo.
+ * @param selected selected[alg] != 0 para simular alg
+ * @param cost Coste de los cambios de contexto (NULL = gratis)
+ * @param runs Array de k * SCHED_COUNT; runs[r * SCHED_COUNT + alg]
+ * @return 0 si todo fue bien, -1 con el motivo en err (sin memoria o una
+ *         réplica con tiempos fuera de rango)
+ */
+int replicate_run(const gen_spec_t *spec, int k, const int selected[SCHED_COUNT],
+                  int quantum, mlfq_config_t *config, const switch_cost_t *cost,
+                  int num_threads, metrics_t *runs, char *err, size_t errlen);
+
+/**
+ * Nombre de la métrica i (0..REP_METRICS-1), p. ej. "avg_turnaround" o
+ * "response_p99".
+ */
+const char *rep_metric_name(int i);
+double rep_metric_value(const metrics_t *m, int i);
+
+/**
+ * Media, desviación típica e IC del 95% (t de Student) de cada métrica
+ * sobre k ejecuciones separadas `stride` elementos en runs.
+ */
+void rep_summarize(const metrics_t *runs, int k, int stride,
+                   rep_stat_t out[REP_METRICS]);
+
+#endif // REPLICATE_H
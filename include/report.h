@@ -5,7 +5,9 @@
 #include "metrics.h"
 
 /**
- * Genera un informe de comparación de algoritmos.
+ * Genera un informe de comparación de algoritmos.  Cada algoritmo se
+ * ejecuta en paralelo sobre su propia copia de los procesos (que no se
+ * modifican) y sus métricas usan su makespan real.
  * @param filename Nombre del archivo de salida (.md o .html)
  * @param processes Conjunto de procesos simulados
  * @param n Número de procesos
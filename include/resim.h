@@ -0,0 +1,130 @@
+#ifndef RESIM_H
+#define RESIM_H
+
+#include "scheduler.h"
+#include "algorithms.h"
+#include "proctable.h"
+#include "timeline.h"
+
+// -----------------------------
+// Re-simulación incremental
+// -----------------------------
+// Mantiene una carga ordenada por llegada junto con el resultado de su
+// última ejecución y una instantánea del planificador (sched_save) cada
+// `interval` decisiones.  Hasta el instante T en que llega un proceso la
+// simulación no depende de él: no está en ninguna cola y ningún tramo
+// anterior termina después de T.  Así que tras añadir o quitar procesos
+// resim_run reanuda desde la última instantánea anterior a la menor
+// llegada tocada, recortando la línea de tiempo en ese punto, en lugar de
+// empezar desde 0.  Cambiar el algoritmo o sus parámetros invalida todas
+// las instantáneas.
+//
+// Una ejecución también se puede hacer por partes (resim_begin,
+// resim_advance, resim_end), p. ej. desde otro hilo mientras la interfaz
+// muestra el progreso.
+typedef struct {
+    proc_table_t pt;            // Procesos por (arrival, orden de inserción),
+                                // con los resultados de la última ejecución
+    timeline_t timeline;        // Línea de tiempo de la última ejecución
+    switch_stats_t stats;
+    sched_alg_t alg;
+    int quantum;
+    mlfq_config_t *config;      // Debe vivir tanto como el resim_t
+    int interval;               // Decisiones entre instantáneas
+    int every;                  // Intervalo actual: se duplica cuando hay
+                                // demasiadas instantáneas
+    sched_snapshot_t *snaps;    // Por tiempo creciente
+    int num_snaps;
+    int dirty;                  // Menor llegada tocada desde la última
+                                // ejecución (INT_MAX = ninguna)
+    int resumed_at;             // Última ejecución: instante desde el que
+                                // se reanudó (0 = desde el principio)
+    long long steps;            // Última ejecución: decisiones simuladas
+    int running;                // Entre resim_begin y resim_end
+    int failed;                 // La ejecución en curso se quedó sin memoria
+    sched_state_t st;           // Ejecución en curso
+    long long step;             // Decisiones desde el principio
+    timeline_sink_t sink;       // Hacia timeline y tap
+    const timeline_sink_t *tap;
+} resim_t;
+
+/**
+ * @param interval Decisiones entre instantáneas (> 0): menos memoria con
+ *                 valores grandes, menos trabajo repetido con pequeños.
+ *                 Se duplica cuando se acumulan demasiadas, así que en
+ *                 ejecuciones largas la memoria sigue acotada.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int resim_init(resim_t *rs, int interval);
+void resim_free(resim_t *rs);
+
+/**
+ * Sustituye la carga por `processes` (se copian, ráfagas de E/S
+ * incluidas) y descarta las instantáneas.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int resim_load(resim_t *rs, const process_t *processes, int n);
+
+/**
+ * Fija el algoritmo; si cambia algo que afecte a la simulación se
+ * descartan las instantáneas.  Tras modificar el contenido de config hay
+ * que llamar a resim_invalidate.
+ */
+void resim_set_policy(resim_t *rs, sched_alg_t alg, int quantum,
+                      mlfq_config_t *config);
+void resim_invalidate(resim_t *rs);
+
+/**
+ * Añade p detrás de los procesos que llegan a la vez o antes.
+ * @return Posición en rs->pt, o -1 si no hay memoria
+ */
+int resim_add(resim_t *rs, const process_t *p);
+
+/**
+ * Quita el proceso de la posición pos.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int resim_remove(resim_t *rs, int pos);
+
+/**
+ * Posición del primer proceso con ese pid, o -1.
+ */
+int resim_find(const resim_t *rs, int pid);
+
+/**
+ * Simula lo que haya cambiado desde la última ejecución y deja en rs->pt,
+ * rs->timeline y rs->stats lo mismo que una ejecución completa.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int resim_run(resim_t *rs);
+
+/**
+ * resim_run por partes.  resim_begin restaura la instantánea y recorta
+ * rs->timeline; a partir de ahí, hasta resim_end, sólo el hilo que
+ * avanza puede tocar rs, salvo leer los datos de entrada de rs->pt (pid,
+ * arrival, burst, priority, E/S), que no cambian.
+ * Si no hay nada que simular rs->running queda a 0 y rs->resumed_at es el
+ * final de la ejecución anterior.
+ * @param tap Recibe también cada evento nuevo (puede ser NULL)
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int resim_begin(resim_t *rs, const timeline_sink_t *tap);
+
+/**
+ * Toma hasta k decisiones y entrega al tap todo lo ejecutado hasta ahora.
+ * @return Decisiones tomadas (< k sólo si la simulación terminó o se quedó
+ *         sin memoria; resim_end lo distingue)
+ */
+long long resim_advance(resim_t *rs, long long k);
+
+/**
+ * Cierra la ejecución.  Si no había terminado, los procesos que no
+ * llegaron a terminar quedan con completion = 0 y la siguiente ejecución
+ * continúa desde la última instantánea.
+ * @return 1 si la simulación llegó al final, 0 si se interrumpió, -1 si
+ *         no hubo memoria para la cola de listos o la línea de tiempo (la
+ *         siguiente ejecución vuelve a empezar desde 0)
+ */
+int resim_end(resim_t *rs);
+
+#endif // RESIM_H
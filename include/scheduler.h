@@ -13,8 +13,15 @@ typedef struct {
     int start_time;         // Primer momento en que fue planificado
     int completion_time;    // Momento en que finalizó
     int turnaround_time;    // turnaround = completion - arrival
-    int waiting_time;       // waiting = turnaround - burst
+    int waiting_time;       // waiting = turnaround - burst - io
     int response_time;      // response = start - arrival
+    // Ráfagas de E/S: el proceso alterna CPU y E/S (bursts = CPU, E/S,
+    // CPU, ..., E/S, CPU; num_bursts impar).  burst_time es la suma de las
+    // de CPU.  num_bursts <= 1 = una sola ráfaga de CPU (bursts puede ser
+    // NULL); el arreglo pertenece a quien cargó la carga (workload_t).
+    int io_time;            // Suma de las ráfagas de E/S
+    int num_bursts;
+    const int *bursts;
 } process_t;
 
 // -----------------------------
@@ -24,6 +31,27 @@ typedef struct {
     int time;       // Momento en que comienza el evento
     int pid;        // Proceso en ejecución
     int duration;   // Duración del evento
+    int cpu;        // CPU que lo ejecutó (0 en los modos de una CPU)
 } timeline_event_t;
 
+// -----------------------------
+// Coste de los cambios de contexto
+// -----------------------------
+// Cada vez que la CPU pasa a un proceso distinto del último que ejecutó
+// pierde switch_time unidades más la recarga de su caché, que crece con el
+// tiempo que el proceso pasó fuera: cache_penalty * min(fuera, cache_decay)
+// / cache_decay.  Un proceso que aún no se ha ejecutado paga la recarga
+// completa.  Todo a 0 reproduce el modelo sin coste.
+typedef struct {
+    int switch_time;        // Coste fijo de cada cambio
+    int cache_penalty;      // Recarga de una caché completamente fría
+    int cache_decay;        // Tiempo fuera tras el que la caché está fría
+                            // (<= 0: fría en cuanto el proceso sale)
+} switch_cost_t;
+
+typedef struct {
+    long long switches;     // Cambios de proceso en la CPU
+    long long overhead;     // Tiempo perdido en ellos (cambio + caché)
+} switch_stats_t;
+
 #endif // SCHEDULER_H
@@ -0,0 +1,49 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stdint.h>
+#include "proctable.h"
+
+// -----------------------------
+// Núcleos vectoriales con selección en tiempo de ejecución
+// -----------------------------
+// Cada núcleo tiene versión escalar y versiones SSE2/AVX2 en x86; la
+// primera llamada elige la mejor que soporte la CPU.  SCHED_SIMD=scalar,
+// sse2 o avx2 en el entorno limita el nivel (para comparar o depurar).
+// Todos los niveles dan exactamente el mismo resultado.
+typedef enum { SIMD_SCALAR = 0, SIMD_SSE2, SIMD_AVX2 } simd_level_t;
+
+simd_level_t simd_level(void);
+const char *simd_level_name(simd_level_t level);
+
+// Acumuladores de calculate_metrics_table.  Las sumas son enteras (exactas);
+// los cuadrados van en 4 carriles double (el proceso i suma en el carril
+// i % 4) para que el orden de las sumas no dependa del nivel.
+typedef struct {
+    long long turnaround;
+    long long waiting;
+    long long response;
+    long long busy;
+    double turnaround2[4];
+    int min[3];             // turnaround, waiting, response (negativos = 0)
+    int max[3];
+} simd_sums_t;
+
+void simd_sums_init(simd_sums_t *s);
+
+/**
+ * Una pasada sobre los procesos [from, from + n) de la tabla: acumula en s
+ * y escribe en buckets la cubeta (hist_bucket) de turnaround, waiting y
+ * response: buckets[0..n), buckets[n..2n) y buckets[2n..3n).
+ * from debe ser múltiplo de 4.
+ */
+void simd_latency_block(const proc_table_t *pt, int from, int n,
+                        simd_sums_t *s, int *buckets);
+
+/**
+ * Posición del menor valor de v[0..n) (la primera si se repite), o -1 si
+ * n == 0.  Pensado para conjuntos pequeños (colas de listos cortas).
+ */
+int simd_argmin_i64(const int64_t *v, int n);
+
+#endif // SIMD_H
@@ -0,0 +1,90 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "proctable.h"
+#include "timeline.h"
+
+// -----------------------------
+// Simulación multiprocesador (SMP)
+// -----------------------------
+// num_cpus CPUs, cada una con su cola de listos y la política de siempre
+// (FIFO, SJF, STCF, RR o MLFQ).  El reparto entre CPUs:
+//   SMP_GLOBAL  una única cola compartida por todas las CPUs
+//   SMP_PUSH    cada llegada va a la siguiente CPU en turno rotatorio y
+//               cada balance_interval la CPU más cargada empuja procesos
+//               a la menos cargada hasta que difieren en 1 como mucho
+//   SMP_STEAL   mismo reparto inicial; una CPU que se queda sin trabajo
+//               roba la mitad de la cola más larga
+// Con una CPU los tres modos dan el mismo resultado que schedule_run_table.
+//
+// En push y steal cada CPU sólo toca su propia cola entre dos momentos de
+// balanceo, así que puede simular por su cuenta: las CPUs avanzan en
+// ventanas, repartidas entre `threads` hilos, y se sincronizan al final de
+// cada una para balancear o robar.  El resultado es idéntico con cualquier
+// número de hilos.
+typedef enum { SMP_GLOBAL = 0, SMP_PUSH, SMP_STEAL, SMP_BALANCE_COUNT } smp_balance_t;
+
+typedef struct {
+    int num_cpus;
+    smp_balance_t balance;
+    int balance_interval;   // SMP_PUSH: periodo del balanceo (> 0)
+    int threads;            // Hilos para push/steal: 1 = secuencial,
+                            // <= 0 = todos los núcleos (máximo num_cpus)
+} smp_config_t;
+
+// Resultados que no caben en la tabla de procesos
+typedef struct {
+    int num_cpus;
+    long long *busy;        // Tiempo ocupado de cada CPU
+    long long migrations;   // Veces que un proceso siguió en otra CPU
+    long long switches;     // Cambios de proceso, sumados en todas las CPUs
+    int makespan;
+} smp_stats_t;
+
+const char *smp_balance_name(smp_balance_t balance);
+
+/**
+ * Convierte "global", "push" o "steal" en identificador.
+ * @return Identificador, o -1 si el nombre no existe
+ */
+int smp_balance_parse(const char *name);
+
+/**
+ * Por defecto: 4 CPUs, robo de trabajo, balanceo cada 10 unidades, un
+ * hilo.
+ */
+void smp_config_default(smp_config_t *cfg);
+
+/**
+ * Ejecuta `alg` sobre la tabla con cfg->num_cpus CPUs.  Igual que
+ * schedule_run_table sólo escribe remaining, start y completion.  Los
+ * eventos llevan la CPU en timeline_event_t.cpu; los de cada CPU llegan
+ * al sink en orden de tiempo.  El sink sólo se llama desde el hilo que
+ * llama a smp_run.
+ * @param stats Se reserva aquí; liberar con smp_stats_free
+ * @return 0 si todo fue bien, -1 si no hay memoria, el sink perdió algún
+ *         evento o la tabla tiene ráfagas de E/S (no se modelan con
+ *         varias CPUs)
+ */
+int smp_run(sched_alg_t alg, proc_table_t *pt, int quantum, mlfq_config_t *config,
+            const smp_config_t *cfg, const timeline_sink_t *sink, smp_stats_t *stats);
+
+void smp_stats_free(smp_stats_t *stats);
+
+/**
+ * Porcentaje del makespan que la CPU estuvo ocupada.
+ */
+double smp_cpu_utilization(const smp_stats_t *stats, int cpu);
+
+/**
+ * Métricas de una ejecución SMP: calculate_metrics_table_cpus más las
+ * migraciones y los cambios de contexto (sin coste: smp_run no modela
+ * switch_cost_t).
+ */
+void smp_metrics(const proc_table_t *pt, const smp_stats_t *stats,
+                 metrics_t *metrics);
+
+#endif // SMP_H
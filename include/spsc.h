@@ -0,0 +1,54 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stddef.h>
+
+// -----------------------------
+// Anillo sin cerrojos de un productor y un consumidor
+// -----------------------------
+// Buffer circular de elementos de tamaño fijo entre exactamente dos hilos:
+// uno sólo escribe (spsc_push*) y el otro sólo lee (spsc_pop).  Cada lado
+// avanza su propio contador y publica con una escritura release; el otro
+// lo lee con acquire, así que los elementos copiados antes son visibles.
+// Los contadores están en líneas de caché distintas para que los dos
+// hilos no se las disputen.
+typedef struct {
+    size_t head;            // Elementos leídos (sólo lo escribe el consumidor)
+    char pad0[64 - sizeof(size_t)];
+    size_t tail;            // Elementos escritos (sólo lo escribe el productor)
+    char pad1[64 - sizeof(size_t)];
+    unsigned char *buf;
+    size_t elem;            // Tamaño de cada elemento
+    size_t mask;            // Capacidad - 1 (la capacidad es potencia de 2)
+} spsc_t;
+
+/**
+ * @param elem Tamaño de cada elemento en bytes
+ * @param capacity Elementos (se redondea a la siguiente potencia de 2)
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int spsc_init(spsc_t *q, size_t elem, size_t capacity);
+void spsc_free(spsc_t *q);
+
+/**
+ * Productor: copia hasta count elementos sin esperar.
+ * @return Elementos copiados (menos de count si el anillo se llenó)
+ */
+size_t spsc_push(spsc_t *q, const void *items, size_t count);
+
+/**
+ * Productor: copia los count elementos, esperando mientras el anillo
+ * esté lleno (primero cede el núcleo, luego duerme de milisegundo en
+ * milisegundo: el consumidor puede tardar un fotograma en vaciarlo).
+ * Deja de esperar si *stop pasa a ser distinto de 0.
+ * @return Elementos copiados (count salvo que se pidiera parar)
+ */
+size_t spsc_push_wait(spsc_t *q, const void *items, size_t count, const int *stop);
+
+/**
+ * Consumidor: extrae hasta max elementos, los más antiguos primero.
+ * @return Elementos extraídos (0 si estaba vacío)
+ */
+size_t spsc_pop(spsc_t *q, void *items, size_t max);
+
+#endif // SPSC_H
@@ -0,0 +1,88 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stddef.h>
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "proctable.h"
+
+// -----------------------------
+// Barrido de parámetros de RR y MLFQ
+// -----------------------------
+#define SWEEP_MAX_LEVELS 16
+
+// Rango entero lo..hi (inclusive) con paso step
+typedef struct {
+    int lo;
+    int hi;
+    int step;
+} sweep_range_t;
+
+typedef struct {
+    sweep_range_t quantum;      // RR: quantum (lo = 0 desactiva RR)
+    sweep_range_t levels;       // MLFQ: número de niveles (lo = 0 desactiva MLFQ)
+    sweep_range_t base;         // MLFQ: quantum del nivel 0
+    sweep_range_t growth;       // MLFQ: factor entre niveles (quantum_i = base * growth^i)
+    sweep_range_t boost;        // MLFQ: intervalo de boost (0 = sin boost)
+    switch_cost_t cost;         // Coste de cambio común a todas (0 = gratis)
+} sweep_spec_t;
+
+// Una configuración y sus resultados
+typedef struct {
+    sched_alg_t alg;            // SCHED_RR o SCHED_MLFQ
+    int quantum;                // RR
+    int num_queues;             // MLFQ
+    int quantums[SWEEP_MAX_LEVELS];
+    int boost_interval;
+    int makespan;
+    metrics_t metrics;
+    double sim_seconds;
+    int pareto;                 // 1 si está en el frente de Pareto
+} sweep_result_t;
+
+/**
+ * Por defecto: RR con q=1..10; MLFQ con 2..4 niveles, quantum base 1..4,
+ * factor 2 y boost 0..200 de 50 en 50, sin coste de cambio.
+ */
+void sweep_spec_default(sweep_spec_t *spec);
+
+/**
+ * Aplica pares "clave=lo:hi[:paso]" (o un único valor) separados por comas,
+ * p. ej. "q=1:20,levels=3,base=1:8,growth=1:3,boost=0:400:100".  Claves:
+ * q, levels, base, growth, boost.
+ * @return 0 si todo fue bien, -1 con el motivo en err
+ */
+int sweep_spec_parse(sweep_spec_t *spec, const char *text, char *err, size_t errlen);
+
+/**
+ * Número de configuraciones que genera spec.
+ */
+int sweep_count(const sweep_spec_t *spec);
+
+/**
+ * Ejecuta todas las configuraciones repartidas entre num_threads hilos
+ * (<= 0 = todos los núcleos) con robo de trabajo.  Los campos de entrada
+ * de pt se comparten en sólo lectura; cada hilo sólo tiene sus propios
+ * remaining/start/completion (proc_table_init_shared).
+ * Marca el frente de Pareto con sweep_pareto.
+ * @param results Array de sweep_count(spec) elementos
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int sweep_run(const sweep_spec_t *spec, const proc_table_t *pt,
+              int num_threads, sweep_result_t *results);
+
+/**
+ * Marca en `pareto` las configuraciones no dominadas en (turnaround medio,
+ * p99 de response), ambos a minimizar.
+ * @return Número de configuraciones en el frente
+ */
+int sweep_pareto(sweep_result_t *results, int count);
+
+/**
+ * Escribe la configuración como texto, p. ej. "RR q=4" o
+ * "MLFQ 2:4:8 boost=50".
+ */
+void sweep_label(const sweep_result_t *r, char *buf, size_t len);
+
+#endif // SWEEP_H
@@ -0,0 +1,103 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "scheduler.h"
+
+// -----------------------------
+// Línea de tiempo creciente
+// -----------------------------
+// Arreglo dinámico de eventos con capacidad y número de eventos.  Los
+// tramos consecutivos del mismo proceso se funden en un único evento,
+// así que hay un evento por cambio de contexto y no uno por unidad.
+typedef struct {
+    timeline_event_t *events;
+    int count;      // Eventos válidos
+    int capacity;   // Eventos reservados
+    int failed;     // Como sink: algún evento no cupo (hasta timeline_clear)
+} timeline_t;
+
+/**
+ * @param capacity Capacidad inicial (crece al doble cuando se llena)
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int timeline_init(timeline_t *tl, int capacity);
+void timeline_free(timeline_t *tl);
+
+/**
+ * Vacía la línea de tiempo conservando la memoria reservada.
+ */
+void timeline_clear(timeline_t *tl);
+
+/**
+ * Quita lo que ocurre desde `time` en adelante: los eventos que empiezan
+ * después y la parte final del que está en curso.  Los eventos deben
+ * estar ordenados por tiempo (una sola CPU).
+ */
+void timeline_truncate(timeline_t *tl, int time);
+
+/**
+ * Añade un tramo de ejecución en la CPU 0; si continúa al último evento
+ * del mismo pid, lo alarga en lugar de crear uno nuevo.
+ * @return 0 si todo fue bien, -1 si no hay memoria para crecer
+ */
+int timeline_append(timeline_t *tl, int time, int pid, int duration);
+
+/**
+ * Igual con la CPU del evento; sólo se funde con el último evento si es
+ * de la misma CPU.
+ */
+int timeline_append_event(timeline_t *tl, const timeline_event_t *ev);
+
+// -----------------------------
+// Sink: destino de eventos en streaming
+// -----------------------------
+// Los algoritmos entregan cada evento (ya fusionado) a on_event en cuanto
+// termina, sin guardarlo.  flush es opcional y se llama al final de la
+// simulación para que el sink vacíe lo que tenga acumulado; devuelve -1 si
+// el sink perdió algún evento (p. ej. por falta de memoria), y la
+// simulación lo devuelve como error.
+typedef struct {
+    void (*on_event)(void *ctx, const timeline_event_t *ev);
+    int (*flush)(void *ctx);        // Puede ser NULL
+    void *ctx;
+} timeline_sink_t;
+
+/**
+ * Sink que añade los eventos a `tl`; si uno no cabe se anota en
+ * tl->failed y flush devuelve -1.
+ */
+timeline_sink_t timeline_as_sink(timeline_t *tl);
+
+// -----------------------------
+// Stream: fusiona tramos antes de entregarlos al sink
+// -----------------------------
+// Retiene el último evento hasta saber que el siguiente tramo no lo
+// continúa; la memoria usada es constante.  Con varias CPUs se usa un
+// stream por CPU, todos hacia el mismo sink.
+typedef struct {
+    const timeline_sink_t *sink;    // NULL = descartar los eventos
+    timeline_event_t pending;
+    int has_pending;
+    int cpu;                        // CPU que se anota en los eventos
+} timeline_stream_t;
+
+/**
+ * Prepara el stream para la CPU 0 (ver stream_begin_cpu).
+ */
+void stream_begin(timeline_stream_t *st, const timeline_sink_t *sink);
+void stream_begin_cpu(timeline_stream_t *st, const timeline_sink_t *sink, int cpu);
+void stream_slice(timeline_stream_t *st, int time, int pid, int duration);
+
+/**
+ * Entrega el evento pendiente y llama a flush del sink.
+ * @return Lo que devuelva flush (0 sin sink o sin flush)
+ */
+int stream_end(timeline_stream_t *st);
+
+/**
+ * Entrega el evento pendiente sin llamar a flush (varios streams hacia el
+ * mismo sink, que se vacía una sola vez).
+ */
+void stream_drain(timeline_stream_t *st);
+
+#endif // TIMELINE_H
@@ -0,0 +1,145 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+// -----------------------------
+// Conjunto de procesos cargado desde archivo
+// -----------------------------
+// Las ráfagas de los procesos con E/S (process_t.bursts) se guardan
+// seguidas en `bursts`, en el orden de los procesos.
+typedef struct {
+    process_t *processes;
+    int n;
+    int capacity;
+    int *bursts;
+    size_t num_bursts;
+    size_t bursts_capacity;
+} workload_t;
+
+// -----------------------------
+// Formato binario (versiones 1 y 2)
+// -----------------------------
+// Cabecera de 32 bytes seguida de `count` registros de 16 bytes; todos
+// los enteros en little-endian.  Se puede mapear y leer sin copiar.
+//
+// La versión 2 añade tras los registros las ráfagas de E/S: `count`
+// uint32 con el número de ráfagas de cada proceso (0 = una sola ráfaga de
+// CPU, la del registro) y después header.bursts int32 con las ráfagas de
+// todos los procesos con E/S, en orden.  En los registros burst_time es
+// el total de CPU.  Sin E/S se escribe la versión 1.
+#define WORKLOAD_MAGIC   "SCHEDWL"
+#define WORKLOAD_VERSION 1
+#define WORKLOAD_VERSION_IO 2
+
+typedef struct {
+    char magic[8];          // "SCHEDWL\0"
+    uint32_t version;       // WORKLOAD_VERSION o WORKLOAD_VERSION_IO
+    uint32_t record_size;   // sizeof(workload_record_t)
+    uint64_t count;         // Número de registros
+    uint64_t bursts;        // Versión 2: ráfagas en la sección final
+} workload_header_t;
+
+typedef struct {
+    int32_t pid;
+    int32_t arrival_time;
+    int32_t burst_time;
+    int32_t priority;
+} workload_record_t;
+
+// Vista de sólo lectura sobre un archivo binario mapeado en memoria
+typedef struct {
+    const workload_record_t *records;
+    size_t count;
+    const uint32_t *burst_counts;   // Versión 2 (NULL en la 1)
+    const int32_t *bursts;
+    size_t num_bursts;
+    void *map;              // Región mapeada (para munmap)
+    size_t map_size;
+} workload_view_t;
+
+void workload_init(workload_t *wl);
+void workload_free(workload_t *wl);
+
+/**
+ * Añade un proceso con los campos de entrada; el resto queda a 0.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int workload_add(workload_t *wl, int pid, int arrival, int burst, int priority);
+
+/**
+ * Añade un proceso con ráfagas alternas de CPU y E/S (num_bursts impar;
+ * con 1 equivale a workload_add).  Las ráfagas se copian.
+ * @return 0 si todo fue bien, -1 si no hay memoria
+ */
+int workload_add_bursts(workload_t *wl, int pid, int arrival, int priority,
+                        const int *bursts, int num_bursts);
+
+// Todas las funciones de carga/guardado devuelven 0 si todo fue bien o
+// -1 con un mensaje en `err` (que puede ser NULL).
+
+/**
+ * Carga un archivo de texto o binario según su cabecera.
+ */
+int workload_load(const char *filename, workload_t *wl, char *err, size_t errlen);
+
+/**
+ * Carga un archivo de texto con una línea "pid arrival burst priority"
+ * por proceso.  Se ignoran líneas vacías y lo que sigue a '#'.  Los
+ * errores indican el número de línea.  Un proceso con E/S sigue con pares
+ * "io burst": "pid arrival cpu priority io cpu io cpu ...".
+ */
+int workload_load_text(const char *filename, workload_t *wl, char *err, size_t errlen);
+
+/**
+ * Carga un archivo binario.  Cada registro se valida como una línea de
+ * texto; los errores indican su índice (desde 0).
+ */
+int workload_load_binary(const char *filename, workload_t *wl, char *err, size_t errlen);
+
+int workload_save_text(const char *filename, const process_t *processes, int n,
+                       char *err, size_t errlen);
+int workload_save_binary(const char *filename, const process_t *processes, int n,
+                         char *err, size_t errlen);
+
+// Escritura incremental (texto o binario) sin guardar todo en memoria
+typedef struct {
+    FILE *f;
+    char *buf;
+    size_t len;
+    uint64_t count;
+    int binary;
+    const char *filename;
+    // Binario: la sección de ráfagas se escribe al cerrar
+    uint32_t *burst_counts;     // NULL hasta el primer proceso con E/S
+    size_t counts_capacity;
+    int32_t *bursts;
+    size_t num_bursts;
+    size_t bursts_capacity;
+    int failed;                 // Sin memoria para la sección de ráfagas
+} workload_writer_t;
+
+int workload_writer_open(workload_writer_t *w, const char *filename, int binary,
+                         char *err, size_t errlen);
+void workload_writer_add(workload_writer_t *w, int pid, int arrival, int burst,
+                         int priority);
+void workload_writer_add_bursts(workload_writer_t *w, int pid, int arrival,
+                                int priority, const int *bursts, int num_bursts);
+
+/**
+ * Vacía el buffer y, en binario, escribe la cuenta final en la cabecera.
+ */
+int workload_writer_close(workload_writer_t *w, char *err, size_t errlen);
+
+/**
+ * Mapea un archivo binario sin copiar los registros, validados como en
+ * workload_load_binary.
+ */
+int workload_map_binary(const char *filename, workload_view_t *view,
+                        char *err, size_t errlen);
+void workload_unmap(workload_view_t *view);
+
+#endif // WORKLOAD_H
@@ -1,162 +1,675 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <strings.h>
 #include "algorithms.h"
+#include "engine.h"
+#include "heap.h"
+#include "queue.h"
+#include "mlfq.h"
+
+// Cada algoritmo es un paso (una decisión) sobre sched_state_t: lo que
+// antes era el cuerpo de su bucle.  Los pasos son static inline para que
+// el bucle de schedule_run_table_cost los especialice sin despacho.
 
 // -----------------------------
 // FIFO (First In First Out)
 // -----------------------------
-void schedule_fifo(process_t *processes, int n, timeline_event_t *timeline) {
-    int time = 0;
-    for (int i = 0; i < n; i++) {
-        process_t *p = &processes[i];
-        if (time < p->arrival_time)
-            time = p->arrival_time;
-        p->start_time = time;
-        p->completion_time = time + p->burst_time;
-        p->turnaround_time = p->completion_time - p->arrival_time;
-        p->waiting_time = p->turnaround_time - p->burst_time;
-        p->response_time = p->start_time - p->arrival_time;
-
-        timeline[i].time = p->start_time;
-        timeline[i].pid = p->pid;
-        timeline[i].duration = p->burst_time;
+// Sin expulsiones cada proceso es un cambio y llega con la caché fría, así
+// que no hace falta el motor: cada paso ejecuta el siguiente proceso de la
+// tabla entero.  Con E/S hace falta la cola de listos: es RR con un
+// quantum infinito.
+static void fifo_init(sched_state_t *st, proc_table_t *pt, const switch_cost_t *cost,
+                      const timeline_sink_t *sink) {
+    sim_t *sim = &st->sim;
+    sim->pt = pt;
+    sim->n = pt->n;
+    sim->order = NULL;
+    sim->next = 0;
+    sim->time = 0;
+    sim->completed = 0;
+    stream_begin(&sim->out, sink);
+    sim->left = sim->phase = sim->wake = NULL;
+    sim->last = -1;
+    sim->stats.switches = 0;
+    sim->stats.overhead = 0;
+    sim->totals = (sim_totals_t){0};
+    st->fast = 1;
+    st->fifo_overhead = cost ? switch_overhead(cost, 1, 0) : 0;
+}
 
-        time += p->burst_time;
+// Ejecuta los procesos next..end-1; el reloj va en locales porque las
+// escrituras en la tabla podrían solaparse con sim
+static void fifo_steps(sched_state_t *st, int end) {
+    sim_t *sim = &st->sim;
+    proc_table_t *pt = sim->pt;
+    timeline_stream_t out = sim->out;
+    int time = sim->time;
+    int overhead = st->fifo_overhead;
+    int begin = sim->next;
+    sim_totals_t sum = sim->totals;
+    for (int i = begin; i < end; i++) {
+        if (time < pt->arrival[i])
+            time = pt->arrival[i];
+        time += overhead;
+        pt->start[i] = time;
+        pt->remaining[i] = 0;
+        stream_slice(&out, time, pt->pid[i], pt->burst[i]);
+        sum.response += time - pt->arrival[i];
+        sum.busy += pt->burst[i];
+        time += pt->burst[i];
+        pt->completion[i] = time;
+        sum.turnaround += time - pt->arrival[i];
     }
+    sum.started += end - begin;
+    sim->totals = sum;
+    sim->out = out;
+    sim->time = time;
+    sim->next = sim->completed = end;
+    if (end > begin)
+        sim->last = end - 1;
+    sim->stats.switches += end - begin;
+    sim->stats.overhead += (long long)(end - begin) * overhead;
 }
 
 // -----------------------------
 // SJF (Shortest Job First)
 // -----------------------------
-void schedule_sjf(process_t *processes, int n, timeline_event_t *timeline) {
-    int completed = 0, time = 0;
-    int used[n];
-    for (int i = 0; i < n; i++) used[i] = 0;
-
-    while (completed < n) {
-        int idx = -1, min_burst = INT_MAX;
-        for (int i = 0; i < n; i++) {
-            if (!used[i] && processes[i].arrival_time <= time) {
-                if (processes[i].burst_time < min_burst) {
-                    min_burst = processes[i].burst_time;
-                    idx = i;
-                }
-            }
+// La clave es la ráfaga de CPU que empieza (remaining al admitirlo): con
+// E/S cada vuelta se ordena por su siguiente ráfaga.
+static inline void sjf_step(sched_state_t *st) {
+    sim_t *sim = &st->sim;
+    proc_table_t *pt = sim->pt;
+    int i;
+    while ((i = sim_admit_next(sim)) >= 0)
+        heap_push(&st->heap, i, pt->remaining[i], pt->pid[i]);
+
+    if (heap_empty(&st->heap)) {
+        sim->time = sim_next_arrival(sim);
+        return;
+    }
+
+    int idx = heap_pop(&st->heap);
+    sim_run(sim, idx, pt->remaining[idx]);
+}
+
+// -----------------------------
+// STCF (Shortest Time to Completion First)
+// -----------------------------
+static inline void stcf_step(sched_state_t *st) {
+    sim_t *sim = &st->sim;
+    proc_table_t *pt = sim->pt;
+    int i;
+    while ((i = sim_admit_next(sim)) >= 0)
+        heap_push(&st->heap, i, pt->remaining[i], pt->pid[i]);
+
+    if (heap_empty(&st->heap)) {
+        sim->time = sim_next_arrival(sim);
+        return;
+    }
+
+    // Sólo una llegada puede cambiar la decisión: se ejecuta hasta
+    // terminar o hasta la próxima llegada, lo que ocurra antes.
+    int idx = heap_peek(&st->heap);
+    int slice = pt->remaining[idx];
+    int next_arrival = sim_next_arrival(sim);
+    if (next_arrival != INT_MAX && next_arrival - sim->time < slice)
+        slice = next_arrival - sim->time;
+
+    sim_run(sim, idx, slice);
+    if (pt->remaining[idx] == 0)
+        heap_pop(&st->heap);
+    else
+        heap_update(&st->heap, idx, pt->remaining[idx]);
+}
+
+// -----------------------------
+// Round Robin
+// -----------------------------
+// Si la cola no puede crecer la simulación se detiene con st->failed
+static inline void rr_step(sched_state_t *st) {
+    sim_t *sim = &st->sim;
+    proc_table_t *pt = sim->pt;
+    int i;
+    while ((i = sim_admit_next(sim)) >= 0)
+        if (queue_push(&st->queue, i) != 0) {
+            st->failed = 1;
+            return;
         }
 
-        if (idx == -1) {
-            time++;
-            continue;
+    if (queue_empty(&st->queue)) {
+        sim->time = sim_next_arrival(sim);
+        return;
+    }
+
+    int idx = queue_pop(&st->queue);
+    int exec_time = (pt->remaining[idx] > st->quantum) ? st->quantum : pt->remaining[idx];
+    sim_run(sim, idx, exec_time);
+
+    // Las llegadas durante el quantum entran antes que el expulsado
+    while ((i = sim_admit_next(sim)) >= 0)
+        if (queue_push(&st->queue, i) != 0) {
+            st->failed = 1;
+            return;
+        }
+    if (pt->remaining[idx] > 0 && queue_push(&st->queue, idx) != 0)
+        st->failed = 1;
+}
+
+// -----------------------------
+// MLFQ (Multi-Level Feedback Queue)
+// -----------------------------
+// Colas por nivel en mlfq.h; el quantum de cada nivel, la cuota
+// (allotment) y el boost vienen de mlfq_config_t.
+static inline void mlfq_enter(const sim_t *sim, mlfq_levels_t *lv, int idx) {
+    if (sim_woke(sim, idx))
+        mlfq_wake(lv, idx);
+    else
+        mlfq_admit(lv, idx);
+}
+
+static inline void mlfq_step(sched_state_t *st) {
+    sim_t *sim = &st->sim;
+    proc_table_t *pt = sim->pt;
+    mlfq_config_t *config = st->config;
+    mlfq_levels_t *lv = &st->lv;
+    long long boost = config->boost_interval;
+    int i;
+    while ((i = sim_admit_next(sim)) >= 0)
+        mlfq_enter(sim, lv, i);
+
+    if (sim->time >= st->next_boost) {
+        mlfq_boost(lv);
+        st->next_boost = (sim->time / boost + 1) * boost;
+    }
+
+    int l = mlfq_top_level(lv);
+    if (l < 0) {
+        // Si todos están en E/S el salto puede cruzar boosts: los
+        // bloqueados deben despertar en el nivel 0 (con uno basta, epoch)
+        sim->time = sim_next_arrival(sim);
+        if (sim->time != INT_MAX && sim->time >= st->next_boost) {
+            mlfq_boost(lv);
+            st->next_boost = ((long long)sim->time / boost + 1) * boost;
         }
+        return;
+    }
+
+    int idx = mlfq_pop(lv, l);
+    mlfq_job_t *j = &lv->job[idx];
+    int quantum = config->quantums[l] > 0 ? config->quantums[l] : 1;
+    int allotment = (config->allotments && config->allotments[l] > 0)
+        ? config->allotments[l] : quantum;
 
-        process_t *p = &processes[idx];
-        p->start_time = time;
-        p->completion_time = time + p->burst_time;
-        p->turnaround_time = p->completion_time - p->arrival_time;
-        p->waiting_time = p->turnaround_time - p->burst_time;
-        p->response_time = p->start_time - p->arrival_time;
+    long long slice = pt->remaining[idx];
+    if (slice > quantum)
+        slice = quantum;
+    if (slice > allotment - j->used)
+        slice = allotment - j->used;
+    // Una llegada entra al nivel 0 y expulsa a cualquier nivel inferior
+    int next_new = sim_next_new(sim);
+    if (l > 0 && next_new != INT_MAX && slice > next_new - sim->time)
+        slice = next_new - sim->time;
+    if (slice > st->next_boost - sim->time)
+        slice = st->next_boost - sim->time;
 
-        timeline[completed].time = p->start_time;
-        timeline[completed].pid = p->pid;
-        timeline[completed].duration = p->burst_time;
+    // Quien vuelve de E/S conserva su nivel: sólo expulsa si es superior a
+    // l, así que el tramo se parte en cada fin de E/S y sigue si no
+    int left = (int)slice;
+    while (left > 0) {
+        int piece = left;
+        int wake = sim_next_wake(sim);
+        if (wake != INT_MAX && piece > wake - sim->time)
+            piece = wake - sim->time;
+        sim_run(sim, idx, piece);
+        j->used += piece;
+        left -= piece;
+
+        while ((i = sim_admit_next(sim)) >= 0)
+            mlfq_enter(sim, lv, i);
+        int top = mlfq_top_level(lv);
+        if (top >= 0 && top < l)
+            break;
+    }
 
-        time += p->burst_time;
-        used[idx] = 1;
-        completed++;
+    // La cuota se cobra también si se bloquea en E/S: ceder la CPU
+    // justo antes de agotarla no evita bajar de nivel
+    if (j->used >= allotment) {
+        if (j->level < st->num_queues - 1)
+            j->level++;
+        j->used = 0;
     }
+    if (pt->remaining[idx] == 0)
+        return;
+    mlfq_push(lv, j->level, idx);
 }
 
 // -----------------------------
-// STCF (Shortest Time to Completion First)
+// Ejecución paso a paso
 // -----------------------------
-void schedule_stcf(process_t *processes, int n, timeline_event_t *timeline) {
-    int time = 0, completed = 0;
-    for (int i = 0; i < n; i++)
-        processes[i].remaining_time = processes[i].burst_time;
-
-    while (completed < n) {
-        int idx = -1, min_remaining = INT_MAX;
-        for (int i = 0; i < n; i++) {
-            if (processes[i].arrival_time <= time && processes[i].remaining_time > 0) {
-                if (processes[i].remaining_time < min_remaining) {
-                    min_remaining = processes[i].remaining_time;
-                    idx = i;
+int sched_init(sched_state_t *st, sched_alg_t alg, proc_table_t *pt, int quantum,
+               mlfq_config_t *config, const switch_cost_t *cost,
+               const timeline_sink_t *sink) {
+    st->alg = alg;
+    st->quantum = quantum;
+    st->config = config;
+    st->num_queues = 1;
+    st->fast = 0;
+    st->failed = 0;
+    st->fifo_overhead = 0;
+    st->next_boost = LLONG_MAX;
+    st->lv = (mlfq_levels_t){0};
+    if (alg == SCHED_FIFO && !pt->first) {
+        fifo_init(st, pt, cost, sink);
+        return 0;
+    }
+    if (alg == SCHED_FIFO)
+        st->quantum = INT_MAX;
+
+    if (sim_init(&st->sim, pt, cost, sink) != 0)
+        return -1;
+    int rc = 0;
+    switch (alg) {
+        case SCHED_SJF:
+        case SCHED_STCF:
+            rc = heap_init(&st->heap, pt->n);
+            break;
+        case SCHED_FIFO:
+        case SCHED_RR:
+            rc = queue_init(&st->queue, 64);
+            break;
+        case SCHED_MLFQ:
+            st->num_queues = config->num_queues > 0 ? config->num_queues : 1;
+            if (config->boost_interval > 0)
+                st->next_boost = config->boost_interval;
+            rc = mlfq_levels_init(&st->lv, st->num_queues, pt->n, NULL);
+            if (rc != 0)
+                mlfq_levels_free(&st->lv);
+            break;
+        default:
+            // Algoritmo desconocido: nada que simular
+            st->sim.n = 0;
+            break;
+    }
+    if (rc != 0) {
+        sim_free(&st->sim);
+        return -1;
+    }
+    return 0;
+}
+
+// Hasta k decisiones, parando antes de una que empezaría en t o después.
+// Cada algoritmo tiene su propio bucle con el paso fijo, sin despacho por
+// decisión.  Sólo RR y FIFO con E/S pueden fallar (la cola crece).
+#define ADVANCE(step)                                               \
+    while (done < k && !sched_done(st) && st->sim.time < t &&      \
+           !st->failed) {                                           \
+        step(st);                                                   \
+        done++;                                                     \
+    }
+
+static long long sched_advance(sched_state_t *st, long long k, long long t) {
+    long long done = 0;
+    switch (st->alg) {
+        case SCHED_FIFO:
+            if (!st->fast) {
+                ADVANCE(rr_step);
+            } else if (t == LLONG_MAX) {
+                // Sin límite de tiempo los procesos van de una pasada
+                long long left = st->sim.n - st->sim.next;
+                done = k < left ? k : left;
+                fifo_steps(st, st->sim.next + (int)done);
+            } else {
+                while (done < k && !sched_done(st) && st->sim.time < t) {
+                    fifo_steps(st, st->sim.next + 1);
+                    done++;
                 }
             }
-        }
+            break;
+        case SCHED_SJF:  ADVANCE(sjf_step); break;
+        case SCHED_STCF: ADVANCE(stcf_step); break;
+        case SCHED_RR:   ADVANCE(rr_step); break;
+        case SCHED_MLFQ: ADVANCE(mlfq_step); break;
+        default: break;
+    }
+    return st->failed ? -1 : done;
+}
 
-        if (idx == -1) {
-            time++;
-            continue;
+#undef ADVANCE
+
+int sched_step(sched_state_t *st) {
+    long long done = sched_advance(st, 1, LLONG_MAX);
+    return done < 0 ? -1 : done > 0;
+}
+
+long long sched_step_events(sched_state_t *st, long long k) {
+    return sched_advance(st, k, LLONG_MAX);
+}
+
+int sched_step_until(sched_state_t *st, long long t) {
+    if (sched_advance(st, LLONG_MAX, t) < 0)
+        return -1;
+    return !sched_done(st);
+}
+
+void sched_flush(sched_state_t *st) {
+    stream_drain(&st->sim.out);
+}
+
+// En FIFO sin E/S los listos son los siguientes procesos de la tabla que ya
+// han llegado; se buscan a saltos crecientes y luego por bisección
+static int fifo_ready(const sched_state_t *st) {
+    const sim_t *sim = &st->sim;
+    const int *arrival = sim->pt->arrival;
+    int lo = sim->next, step = 1;
+    while (lo < sim->n && arrival[lo] <= sim->time) {
+        int hi = lo + step < sim->n ? lo + step : sim->n;
+        if (arrival[hi - 1] > sim->time) {
+            while (lo < hi) {
+                int mid = lo + (hi - lo) / 2;
+                if (arrival[mid] <= sim->time)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            break;
         }
+        lo = hi;
+        step *= 2;
+    }
+    return lo - sim->next;
+}
+
+int sched_ready(const sched_state_t *st) {
+    if (st->fast)
+        return fifo_ready(st);
+    switch (st->alg) {
+        case SCHED_SJF:
+        case SCHED_STCF: return heap_size(&st->heap);
+        case SCHED_FIFO:
+        case SCHED_RR:   return st->queue.count;
+        case SCHED_MLFQ: return st->lv.count;
+        default:         return 0;
+    }
+}
 
-        process_t *p = &processes[idx];
-        if (p->remaining_time == p->burst_time)
-            p->start_time = time;
-
-        p->remaining_time--;
-        timeline[time].time = time;
-        timeline[time].pid = p->pid;
-        timeline[time].duration = 1;
-
-        time++;
-        if (p->remaining_time == 0) {
-            p->completion_time = time;
-            p->turnaround_time = p->completion_time - p->arrival_time;
-            p->waiting_time = p->turnaround_time - p->burst_time;
-            p->response_time = p->start_time - p->arrival_time;
-            completed++;
+int sched_blocked(const sched_state_t *st) {
+    return st->sim.phase ? heap_size(&st->sim.blocked) : 0;
+}
+
+int sched_finish(sched_state_t *st, switch_stats_t *stats) {
+    if (stats)
+        *stats = st->sim.stats;
+    if (!st->fast) {
+        switch (st->alg) {
+            case SCHED_SJF:
+            case SCHED_STCF: heap_free(&st->heap); break;
+            case SCHED_FIFO:
+            case SCHED_RR:   queue_free(&st->queue); break;
+            case SCHED_MLFQ: mlfq_levels_free(&st->lv); break;
+            default: break;
         }
     }
+    if (sim_free(&st->sim) != 0 || st->failed)
+        return -1;
+    return 0;
 }
 
 // -----------------------------
-// Round Robin
+// Instantáneas
 // -----------------------------
-void schedule_rr(process_t *processes, int n, int quantum, timeline_event_t *timeline) {
-    int time = 0, completed = 0;
-    for (int i = 0; i < n; i++)
-        processes[i].remaining_time = processes[i].burst_time;
-
-    while (completed < n) {
-        int idle = 1;
-        for (int i = 0; i < n; i++) {
-            process_t *p = &processes[i];
-            if (p->arrival_time <= time && p->remaining_time > 0) {
-                idle = 0;
-                if (p->remaining_time == p->burst_time)
-                    p->start_time = time;
-
-                int exec_time = (p->remaining_time > quantum) ? quantum : p->remaining_time;
-                p->remaining_time -= exec_time;
-
-                timeline[time].time = time;
-                timeline[time].pid = p->pid;
-                timeline[time].duration = exec_time;
-
-                time += exec_time;
-
-                if (p->remaining_time == 0) {
-                    p->completion_time = time;
-                    p->turnaround_time = p->completion_time - p->arrival_time;
-                    p->waiting_time = p->turnaround_time - p->burst_time;
-                    p->response_time = p->start_time - p->arrival_time;
-                    completed++;
-                }
-            }
+static void save_job(const sched_state_t *st, int idx, sched_saved_job_t *j) {
+    const sim_t *sim = &st->sim;
+    j->idx = idx;
+    j->remaining = sim->pt->remaining[idx];
+    j->start = sim->pt->start[idx];
+    j->left = sim->left ? sim->left[idx] : 0;
+    j->phase = sim->phase ? sim->phase[idx] : 0;
+    j->wake = sim->phase ? sim->wake[idx] : 0;
+    if (st->alg == SCHED_MLFQ)
+        j->mlfq = st->lv.job[idx];
+    else
+        j->mlfq = (mlfq_job_t){0};
+}
+
+int sched_save(const sched_state_t *st, sched_snapshot_t *snap) {
+    const sim_t *sim = &st->sim;
+    // FIFO sin E/S no tiene cola: sus listos son los siguientes de la tabla
+    int ready = st->fast ? 0 : sched_ready(st);
+    int blocked = sched_blocked(st);
+
+    snap->time = sim->time;
+    snap->next = sim->next;
+    snap->completed = sim->completed;
+    snap->last = sim->last;
+    snap->stats = sim->stats;
+    snap->totals = sim->totals;
+    snap->next_boost = st->next_boost;
+    snap->epoch = st->lv.epoch;
+    snap->num_ready = ready;
+    snap->num_active = ready + blocked;
+    snap->level_count = NULL;
+    snap->job = malloc((snap->num_active > 0 ? snap->num_active : 1) *
+                       sizeof(sched_saved_job_t));
+    if (st->alg == SCHED_MLFQ)
+        snap->level_count = calloc(st->num_queues, sizeof(int));
+    if (!snap->job || (st->alg == SCHED_MLFQ && !snap->level_count)) {
+        sched_snapshot_free(snap);
+        return -1;
+    }
+
+    int k = 0;
+    if (!st->fast)
+        switch (st->alg) {
+            case SCHED_SJF:
+            case SCHED_STCF:
+                for (int i = 0; i < ready; i++)
+                    save_job(st, st->heap.idx[i], &snap->job[k++]);
+                break;
+            case SCHED_FIFO:
+            case SCHED_RR:
+                for (int i = 0; i < ready; i++)
+                    save_job(st, st->queue.buf[(st->queue.head + i) % st->queue.capacity],
+                             &snap->job[k++]);
+                break;
+            case SCHED_MLFQ:
+                for (int l = 0; l < st->num_queues; l++)
+                    for (int i = st->lv.head[l]; i >= 0; i = st->lv.job[i].next) {
+                        save_job(st, i, &snap->job[k++]);
+                        snap->level_count[l]++;
+                    }
+                break;
+            default:
+                break;
         }
-        if (idle) time++;
+    for (int i = 0; i < blocked; i++)
+        save_job(st, sim->blocked.idx[i], &snap->job[k++]);
+    return 0;
+}
+
+int sched_restore(sched_state_t *st, const sched_snapshot_t *snap) {
+    sim_t *sim = &st->sim;
+    proc_table_t *pt = sim->pt;
+
+    // Los admitidos que no siguen activos ya terminaron
+    for (int p = 0; p < snap->next; p++)
+        pt->remaining[sim->order ? sim->order[p] : p] = 0;
+    sim->time = snap->time;
+    sim->next = snap->next;
+    sim->completed = snap->completed;
+    sim->last = snap->last;
+    sim->stats = snap->stats;
+    sim->totals = snap->totals;
+    st->next_boost = snap->next_boost;
+    st->lv.epoch = snap->epoch;
+
+    for (int k = 0; k < snap->num_active; k++) {
+        const sched_saved_job_t *j = &snap->job[k];
+        pt->remaining[j->idx] = j->remaining;
+        pt->start[j->idx] = j->start;
+        if (sim->left)
+            sim->left[j->idx] = j->left;
+        if (sim->phase) {
+            sim->phase[j->idx] = j->phase;
+            sim->wake[j->idx] = j->wake;
+        }
+        if (st->alg == SCHED_MLFQ)
+            st->lv.job[j->idx] = j->mlfq;
     }
+
+    int k = 0;
+    if (!st->fast)
+        switch (st->alg) {
+            case SCHED_SJF:
+            case SCHED_STCF:
+                for (; k < snap->num_ready; k++)
+                    heap_push(&st->heap, snap->job[k].idx, snap->job[k].remaining,
+                              pt->pid[snap->job[k].idx]);
+                break;
+            case SCHED_FIFO:
+            case SCHED_RR:
+                for (; k < snap->num_ready; k++)
+                    if (queue_push(&st->queue, snap->job[k].idx) != 0)
+                        return -1;
+                break;
+            case SCHED_MLFQ:
+                for (int l = 0; l < st->num_queues; l++)
+                    for (int c = 0; c < snap->level_count[l]; c++)
+                        mlfq_push(&st->lv, l, snap->job[k++].idx);
+                break;
+            default:
+                break;
+        }
+    for (k = snap->num_ready; k < snap->num_active; k++)
+        heap_push(&sim->blocked, snap->job[k].idx, snap->job[k].wake,
+                  snap->job[k].idx);
+    return 0;
+}
+
+void sched_snapshot_free(sched_snapshot_t *snap) {
+    free(snap->job);
+    free(snap->level_count);
+    snap->job = NULL;
+    snap->level_count = NULL;
+    snap->num_ready = snap->num_active = 0;
 }
 
 // -----------------------------
-// MLFQ (Multi-Level Feedback Queue) - Simplified Version
+// Despacho sobre la tabla SoA y sobre process_t[]
 // -----------------------------
+int schedule_run_table_cost(sched_alg_t alg, proc_table_t *pt, int quantum,
+                            mlfq_config_t *config, const switch_cost_t *cost,
+                            const timeline_sink_t *sink, switch_stats_t *stats) {
+    sched_state_t st;
+    if (stats) {
+        stats->switches = 0;
+        stats->overhead = 0;
+    }
+    if (sched_init(&st, alg, pt, quantum, config, cost, sink) != 0)
+        return -1;
+    sched_step_events(&st, LLONG_MAX);
+    return sched_finish(&st, stats);
+}
+
+int schedule_run_table(sched_alg_t alg, proc_table_t *pt, int quantum,
+                       mlfq_config_t *config, const timeline_sink_t *sink) {
+    return schedule_run_table_cost(alg, pt, quantum, config, NULL, sink, NULL);
+}
+
+// Los motores trabajan sobre la tabla SoA; con process_t[] se convierte a
+// la entrada y se vuelcan los resultados a la salida
+int schedule_run_cost(sched_alg_t alg, process_t *processes, int n, int quantum,
+                      mlfq_config_t *config, const switch_cost_t *cost,
+                      const timeline_sink_t *sink, switch_stats_t *stats) {
+    proc_table_t pt;
+    if (proc_table_from_processes(&pt, processes, n) != 0)
+        return -1;
+    int rc = schedule_run_table_cost(alg, &pt, quantum, config, cost, sink, stats);
+    if (rc == 0)
+        proc_table_to_processes(&pt, processes);
+    proc_table_free(&pt);
+    return rc;
+}
+
+int schedule_run(sched_alg_t alg, process_t *processes, int n, int quantum,
+                 mlfq_config_t *config, const timeline_sink_t *sink) {
+    return schedule_run_cost(alg, processes, n, quantum, config, NULL, sink, NULL);
+}
+
+void schedule_fifo_stream(process_t *processes, int n,
+                          const timeline_sink_t *sink) {
+    schedule_run(SCHED_FIFO, processes, n, 0, NULL, sink);
+}
+
+void schedule_sjf_stream(process_t *processes, int n,
+                         const timeline_sink_t *sink) {
+    schedule_run(SCHED_SJF, processes, n, 0, NULL, sink);
+}
+
+void schedule_stcf_stream(process_t *processes, int n,
+                          const timeline_sink_t *sink) {
+    schedule_run(SCHED_STCF, processes, n, 0, NULL, sink);
+}
+
+void schedule_rr_stream(process_t *processes, int n, int quantum,
+                        const timeline_sink_t *sink) {
+    schedule_run(SCHED_RR, processes, n, quantum, NULL, sink);
+}
+
+void schedule_mlfq_stream(process_t *processes, int n, mlfq_config_t *config,
+                          const timeline_sink_t *sink) {
+    schedule_run(SCHED_MLFQ, processes, n, 0, config, sink);
+}
+
+// -----------------------------
+// Variantes que guardan la línea de tiempo completa en un timeline_t
+// -----------------------------
+static const timeline_sink_t *sink_for(timeline_t *timeline,
+                                       timeline_sink_t *storage) {
+    if (!timeline)
+        return NULL;
+    *storage = timeline_as_sink(timeline);
+    return storage;
+}
+
+void schedule_fifo(process_t *processes, int n, timeline_t *timeline) {
+    timeline_sink_t sink;
+    schedule_fifo_stream(processes, n, sink_for(timeline, &sink));
+}
+
+void schedule_sjf(process_t *processes, int n, timeline_t *timeline) {
+    timeline_sink_t sink;
+    schedule_sjf_stream(processes, n, sink_for(timeline, &sink));
+}
+
+void schedule_stcf(process_t *processes, int n, timeline_t *timeline) {
+    timeline_sink_t sink;
+    schedule_stcf_stream(processes, n, sink_for(timeline, &sink));
+}
+
+void schedule_rr(process_t *processes, int n, int quantum, timeline_t *timeline) {
+    timeline_sink_t sink;
+    schedule_rr_stream(processes, n, quantum, sink_for(timeline, &sink));
+}
+
 void schedule_mlfq(process_t *processes, int n, mlfq_config_t *config,
-                   timeline_event_t *timeline) {
-    // ⚠️ Simplified version placeholder
-    // Full implementation would use multiple queues and boosting logic.
-    // Here we just call Round Robin on highest queue as a stub.
-    schedule_rr(processes, n, config->quantums[0], timeline);
+                   timeline_t *timeline) {
+    timeline_sink_t sink;
+    schedule_mlfq_stream(processes, n, config, sink_for(timeline, &sink));
+}
+
+// -----------------------------
+// Selección de algoritmo por identificador
+// -----------------------------
+static const char *alg_names[SCHED_COUNT] = { "FIFO", "SJF", "STCF", "RR", "MLFQ" };
+
+const char *sched_alg_name(sched_alg_t alg) {
+    return (alg >= 0 && alg < SCHED_COUNT) ? alg_names[alg] : "?";
+}
+
+int sched_alg_parse(const char *name) {
+    for (int i = 0; i < SCHED_COUNT; i++)
+        if (strcasecmp(name, alg_names[i]) == 0)
+            return i;
+    return -1;
 }
@@ -0,0 +1,194 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "engine.h"
+
+typedef struct {
+    int arrival;
+    int idx;
+} arrival_key_t;
+
+static int cmp_arrival(const void *a, const void *b) {
+    const arrival_key_t *x = a, *y = b;
+    if (x->arrival != y->arrival)
+        return (x->arrival < y->arrival) ? -1 : 1;
+    return (x->idx < y->idx) ? -1 : (x->idx > y->idx);
+}
+
+int sim_init(sim_t *sim, proc_table_t *pt, const switch_cost_t *cost,
+             const timeline_sink_t *sink) {
+    int n = pt->n;
+    sim->pt = pt;
+    sim->n = n;
+    sim->order = NULL;
+    sim->next = 0;
+    sim->time = 0;
+    sim->completed = 0;
+    stream_begin(&sim->out, sink);
+    sim->last = -1;
+    sim->stats.switches = 0;
+    sim->stats.overhead = 0;
+    sim->totals = (sim_totals_t){0};
+    sim->left = NULL;
+    sim->phase = NULL;
+    sim->wake = NULL;
+    if (cost) {
+        sim->cost = *cost;
+    } else {
+        switch_cost_t none = {0, 0, 0};
+        sim->cost = none;
+    }
+    // Sólo la recarga parcial depende de cuánto tiempo estuvo fuera
+    if (sim->cost.cache_penalty > 0 && sim->cost.cache_decay > 0) {
+        sim->left = malloc((n > 0 ? n : 1) * sizeof(int));
+        if (!sim->left)
+            return -1;
+    }
+    if (pt->first) {
+        sim->phase = malloc(2 * (n > 0 ? n : 1) * sizeof(int));
+        if (!sim->phase || heap_init(&sim->blocked, n) != 0) {
+            free(sim->phase);
+            free(sim->left);
+            sim->phase = sim->left = NULL;
+            return -1;
+        }
+        sim->wake = sim->phase + n;
+    }
+
+    int sorted = 1;
+    for (int i = 0; i < n; i++) {
+        pt->remaining[i] = pt->burst[i];
+        if (i > 0 && pt->arrival[i] < pt->arrival[i - 1])
+            sorted = 0;
+    }
+    if (sim->phase)
+        for (int i = 0; i < n; i++) {
+            sim->phase[i] = pt->first[i];
+            if (pt->first[i + 1] > pt->first[i])
+                pt->remaining[i] = pt->bursts[pt->first[i]];
+        }
+    // Las trazas suelen venir ya ordenadas: entonces el cursor recorre la
+    // tabla directamente y no hace falta el array de orden
+    if (sorted)
+        return 0;
+
+    sim->order = malloc(n * sizeof(int));
+    arrival_key_t *keys = malloc(n * sizeof(arrival_key_t));
+    if (!sim->order || !keys) {
+        free(sim->order);
+        free(keys);
+        sim->order = NULL;
+        free(sim->left);
+        sim->left = NULL;
+        if (sim->phase)
+            heap_free(&sim->blocked);
+        free(sim->phase);
+        sim->phase = sim->wake = NULL;
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        keys[i].arrival = pt->arrival[i];
+        keys[i].idx = i;
+    }
+    qsort(keys, n, sizeof(arrival_key_t), cmp_arrival);
+    for (int i = 0; i < n; i++)
+        sim->order[i] = keys[i].idx;
+    free(keys);
+    return 0;
+}
+
+int sim_free(sim_t *sim) {
+    int rc = stream_end(&sim->out);
+    free(sim->order);
+    free(sim->left);
+    if (sim->phase)
+        heap_free(&sim->blocked);
+    free(sim->phase);
+    sim->order = NULL;
+    sim->left = NULL;
+    sim->phase = sim->wake = NULL;
+    return rc;
+}
+
+int sim_admit_next(sim_t *sim) {
+    if (sim->phase && !heap_empty(&sim->blocked)) {
+        int idx = heap_peek(&sim->blocked);
+        if (sim->wake[idx] <= sim->time) {
+            heap_pop(&sim->blocked);
+            sim->pt->remaining[idx] = sim->pt->bursts[sim->phase[idx]];
+            return idx;
+        }
+    }
+    if (sim->next >= sim->n)
+        return -1;
+    int idx = sim->order ? sim->order[sim->next] : sim->next;
+    if (sim->pt->arrival[idx] > sim->time)
+        return -1;
+    sim->next++;
+    return idx;
+}
+
+int sim_next_new(const sim_t *sim) {
+    if (sim->next >= sim->n)
+        return INT_MAX;
+    return sim->pt->arrival[sim->order ? sim->order[sim->next] : sim->next];
+}
+
+int sim_next_wake(const sim_t *sim) {
+    if (!sim->phase || heap_empty(&sim->blocked))
+        return INT_MAX;
+    return sim->wake[heap_peek(&sim->blocked)];
+}
+
+int sim_next_arrival(const sim_t *sim) {
+    int t = sim_next_new(sim);
+    int wake = sim_next_wake(sim);
+    return wake < t ? wake : t;
+}
+
+// Aún no ha ejecutado nada de su primera ráfaga de CPU
+static int never_ran(const sim_t *sim, int idx) {
+    const proc_table_t *pt = sim->pt;
+    if (!sim->phase || pt->first[idx + 1] == pt->first[idx])
+        return pt->remaining[idx] == pt->burst[idx];
+    return sim->phase[idx] == pt->first[idx] &&
+           pt->remaining[idx] == pt->bursts[pt->first[idx]];
+}
+
+void sim_run(sim_t *sim, int idx, int duration) {
+    proc_table_t *pt = sim->pt;
+    int first_run = never_ran(sim, idx);
+    if (idx != sim->last) {
+        int off = sim->left && !first_run ? sim->time - sim->left[idx] : 0;
+        int overhead = switch_overhead(&sim->cost, first_run, off);
+        sim->stats.switches++;
+        sim->stats.overhead += overhead;
+        sim->time += overhead;
+        sim->last = idx;
+    }
+    if (first_run) {
+        pt->start[idx] = sim->time;
+        sim->totals.started++;
+        sim->totals.response += sim->time - pt->arrival[idx];
+    }
+
+    stream_slice(&sim->out, sim->time, pt->pid[idx], duration);
+    sim->totals.busy += duration;
+
+    pt->remaining[idx] -= duration;
+    sim->time += duration;
+    if (sim->left)
+        sim->left[idx] = sim->time;
+
+    if (pt->remaining[idx] == 0) {
+        // Con otra ráfaga de CPU pendiente se bloquea en la E/S intermedia
+        if (sim->phase && sim->phase[idx] + 1 < pt->first[idx + 1]) {
+            sim->wake[idx] = sim->time + pt->bursts[sim->phase[idx] + 1];
+            sim->phase[idx] += 2;
+            heap_push(&sim->blocked, idx, sim->wake[idx], idx);
+            return;
+        }
+        pt->completion[idx] = sim->time;
+        sim->completed++;
+        sim->totals.turnaround += sim->time - pt->arrival[idx];
+    }
+}
@@ -0,0 +1,152 @@
+#include <stdlib.h>
+#include "gantt.h"
+
+void gantt_index_init(gantt_index_t *gi) {
+    for (int k = 0; k < GANTT_LEVELS; k++) {
+        gi->level[k] = NULL;
+        gi->capacity[k] = 0;
+    }
+    gi->indexed = 0;
+}
+
+void gantt_index_free(gantt_index_t *gi) {
+    for (int k = 0; k < GANTT_LEVELS; k++)
+        free(gi->level[k]);
+    gantt_index_init(gi);
+}
+
+// Suma n a acc; el tramo más largo gana y, si empatan, el primero
+static inline void node_merge(gantt_node_t *acc, const gantt_node_t *n) {
+    acc->busy += n->busy;
+    if (n->longest > acc->longest ||
+        (n->longest == acc->longest && n->first < acc->first)) {
+        acc->longest = n->longest;
+        acc->first = n->first;
+    }
+}
+
+// Un tramo (quizá recortado) como nodo
+static inline void event_merge(gantt_node_t *acc, int idx, int duration) {
+    gantt_node_t n = { duration, duration, idx };
+    node_merge(acc, &n);
+}
+
+static int put_node(gantt_index_t *gi, int k, int pos, const gantt_node_t *n) {
+    if (pos >= gi->capacity[k]) {
+        int capacity = gi->capacity[k] > 0 ? gi->capacity[k] * 2 : 64;
+        gantt_node_t *level = realloc(gi->level[k], capacity * sizeof(gantt_node_t));
+        if (!level)
+            return -1;
+        gi->level[k] = level;
+        gi->capacity[k] = capacity;
+    }
+    gi->level[k][pos] = *n;
+    return 0;
+}
+
+int gantt_index_update(gantt_index_t *gi, const timeline_t *tl) {
+    // El último evento todavía puede alargarse
+    int limit = tl->count - 1;
+    while (gi->indexed + GANTT_BLOCK <= limit) {
+        gantt_node_t n = { 0, 0, -1 };
+        for (int i = gi->indexed; i < gi->indexed + GANTT_BLOCK; i++)
+            event_merge(&n, i, tl->events[i].duration);
+        int b = gi->indexed / GANTT_BLOCK;
+        if (put_node(gi, 0, b, &n) != 0)
+            return -1;
+
+        // Cada nodo que cierra una pareja crea su padre
+        for (int k = 0; k + 1 < GANTT_LEVELS && (b & 1); k++) {
+            gantt_node_t parent = gi->level[k][b - 1];
+            node_merge(&parent, &gi->level[k][b]);
+            b >>= 1;
+            if (put_node(gi, k + 1, b, &parent) != 0)
+                return -1;
+        }
+        gi->indexed += GANTT_BLOCK;
+    }
+    return 0;
+}
+
+void gantt_index_truncate(gantt_index_t *gi, int count) {
+    // Los nodos de bloques completos siguen valiendo: basta con dejar de
+    // contarlos
+    int keep = count > 0 ? count - 1 : 0;
+    keep -= keep % GANTT_BLOCK;
+    if (keep < gi->indexed)
+        gi->indexed = keep;
+}
+
+static void scan(gantt_node_t *acc, const timeline_t *tl, int lo, int hi) {
+    for (int i = lo; i < hi; i++)
+        event_merge(acc, i, tl->events[i].duration);
+}
+
+// La parte del evento idx que cae en [from, to)
+static void clipped_merge(gantt_node_t *acc, const timeline_t *tl, int idx,
+                          long long from, long long to) {
+    const timeline_event_t *e = &tl->events[idx];
+    long long s = e->time > from ? e->time : from;
+    long long t = (long long)e->time + e->duration;
+    if (t > to)
+        t = to;
+    event_merge(acc, idx, (int)(t - s));
+}
+
+gantt_column_t gantt_query(const gantt_index_t *gi, const timeline_t *tl,
+                           long long from, long long to) {
+    gantt_column_t col = { -1, 0 };
+    const timeline_event_t *ev = tl->events;
+
+    // [i, j): eventos que se solapan con el intervalo
+    int lo = 0, hi = tl->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if ((long long)ev[mid].time + ev[mid].duration <= from)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    int i = lo;
+    hi = tl->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (ev[mid].time < to)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    int j = lo;
+    if (i >= j)
+        return col;
+
+    // Los de los bordes, recortados
+    gantt_node_t acc = { 0, 0, -1 };
+    clipped_merge(&acc, tl, i, from, to);
+    if (j - 1 > i)
+        clipped_merge(&acc, tl, j - 1, from, to);
+
+    // El interior: bloques completos por la pirámide, el resto uno a uno
+    lo = i + 1;
+    hi = j - 1;
+    int blo = (lo + GANTT_BLOCK - 1) / GANTT_BLOCK;
+    int bhi = (hi < gi->indexed ? hi : gi->indexed) / GANTT_BLOCK;
+    if (blo < bhi) {
+        scan(&acc, tl, lo, blo * GANTT_BLOCK);
+        scan(&acc, tl, bhi * GANTT_BLOCK, hi);
+        for (int k = 0; blo < bhi; k++) {
+            if (blo & 1)
+                node_merge(&acc, &gi->level[k][blo++]);
+            if (bhi & 1)
+                node_merge(&acc, &gi->level[k][--bhi]);
+            blo >>= 1;
+            bhi >>= 1;
+        }
+    } else {
+        scan(&acc, tl, lo, hi);
+    }
+
+    col.pid = ev[acc.first].pid;
+    col.busy = acc.busy;
+    return col;
+}
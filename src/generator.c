@@ -0,0 +1,426 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "generator.h"
+
+// -----------------------------
+// PRNG
+// -----------------------------
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void rng_seed(rng_t *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++)
+        rng->s[i] = splitmix64(&seed);
+}
+
+uint64_t rng_next(rng_t *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+double rng_uniform(rng_t *rng) {
+    return ((rng_next(rng) >> 11) + 1) * 0x1.0p-53;
+}
+
+double rng_exponential(rng_t *rng, double mean) {
+    return -mean * log(rng_uniform(rng));
+}
+
+// -----------------------------
+// Especificación
+// -----------------------------
+void gen_spec_default(gen_spec_t *spec) {
+    memset(spec, 0, sizeof(*spec));
+    spec->seed = 1;
+    spec->count = 1000;
+    spec->arrival = ARRIVAL_POISSON;
+    spec->rate = 0.1;
+    spec->burst_rate = 1.0;
+    spec->mean_off = 1000.0;
+    spec->mean_on = 100.0;
+    spec->burst = BURST_EXPONENTIAL;
+    spec->mean = 8.0;
+    spec->short_mean = 2.0;
+    spec->long_mean = 50.0;
+    spec->long_fraction = 0.1;
+    spec->alpha = 1.5;
+    spec->min = 1.0;
+    spec->num_priorities = 4;
+    for (int i = 0; i < spec->num_priorities; i++)
+        spec->priority_weights[i] = 1.0;
+    spec->io_fraction = 0.0;
+    spec->io_cpu = 2.0;
+    spec->io_wait = 20.0;
+}
+
+static int parse_priorities(gen_spec_t *spec, const char *v) {
+    char *end;
+    if (!strchr(v, ':')) {
+        long k = strtol(v, &end, 10);
+        if (*end || k < 1 || k > GEN_MAX_PRIORITIES)
+            return -1;
+        spec->num_priorities = (int)k;
+        for (int i = 0; i < k; i++)
+            spec->priority_weights[i] = 1.0;
+        return 0;
+    }
+
+    int k = 0;
+    const char *c = v;
+    for (;;) {
+        if (k == GEN_MAX_PRIORITIES)
+            return -1;
+        double w = strtod(c, &end);
+        if (end == c || w < 0)
+            return -1;
+        spec->priority_weights[k++] = w;
+        if (*end == '\0')
+            break;
+        if (*end != ':')
+            return -1;
+        c = end + 1;
+    }
+    spec->num_priorities = k;
+    return 0;
+}
+
+int gen_spec_parse(gen_spec_t *spec, const char *text, char *err, size_t errlen) {
+    char *copy = strdup(text);
+    if (!copy) {
+        snprintf(err, errlen, "out of memory");
+        return -1;
+    }
+
+    int rc = 0;
+    char *save;
+    for (char *tok = strtok_r(copy, ",", &save); tok && rc == 0;
+         tok = strtok_r(NULL, ",", &save)) {
+        char *eq = strchr(tok, '=');
+        if (!eq) {
+            snprintf(err, errlen, "'%s': expected key=value", tok);
+            rc = -1;
+            break;
+        }
+        *eq = '\0';
+        const char *key = tok, *val = eq + 1;
+        char *end;
+        double num = strtod(val, &end);
+        int numeric = (end != val && *end == '\0');
+
+        if (strcmp(key, "arrival") == 0) {
+            if (strcmp(val, "poisson") == 0) spec->arrival = ARRIVAL_POISSON;
+            else if (strcmp(val, "mmpp") == 0) spec->arrival = ARRIVAL_MMPP;
+            else rc = -1;
+        } else if (strcmp(key, "burst") == 0) {
+            if (strcmp(val, "exp") == 0 || strcmp(val, "exponential") == 0)
+                spec->burst = BURST_EXPONENTIAL;
+            else if (strcmp(val, "bimodal") == 0) spec->burst = BURST_BIMODAL;
+            else if (strcmp(val, "pareto") == 0) spec->burst = BURST_PARETO;
+            else rc = -1;
+        } else if (strcmp(key, "prio") == 0) {
+            rc = parse_priorities(spec, val);
+        } else if (!numeric) {
+            rc = -1;
+        } else if (strcmp(key, "n") == 0 && num >= 0 && num <= INT_MAX) {
+            spec->count = (long long)num;
+        } else if (strcmp(key, "seed") == 0) {
+            spec->seed = strtoull(val, NULL, 10);
+        } else if (strcmp(key, "rate") == 0 && num > 0) {
+            spec->rate = num;
+        } else if (strcmp(key, "burst_rate") == 0 && num > 0) {
+            spec->burst_rate = num;
+        } else if (strcmp(key, "on") == 0 && num > 0) {
+            spec->mean_on = num;
+        } else if (strcmp(key, "off") == 0 && num > 0) {
+            spec->mean_off = num;
+        } else if (strcmp(key, "mean") == 0 && num > 0) {
+            spec->mean = num;
+        } else if (strcmp(key, "short") == 0 && num > 0) {
+            spec->short_mean = num;
+        } else if (strcmp(key, "long") == 0 && num > 0) {
+            spec->long_mean = num;
+        } else if (strcmp(key, "long_fraction") == 0 && num >= 0 && num <= 1) {
+            spec->long_fraction = num;
+        } else if (strcmp(key, "alpha") == 0 && num > 0) {
+            spec->alpha = num;
+        } else if (strcmp(key, "min") == 0 && num >= 1) {
+            spec->min = num;
+        } else if (strcmp(key, "io") == 0 && num >= 0 && num <= 1) {
+            spec->io_fraction = num;
+        } else if (strcmp(key, "io_cpu") == 0 && num > 0) {
+            spec->io_cpu = num;
+        } else if (strcmp(key, "io_wait") == 0 && num > 0) {
+            spec->io_wait = num;
+        } else {
+            rc = -1;
+        }
+        if (rc != 0)
+            snprintf(err, errlen, "invalid workload spec entry '%s=%s'", key, val);
+    }
+    free(copy);
+    return rc;
+}
+
+// -----------------------------
+// Generador
+// -----------------------------
+void gen_init(generator_t *g, const gen_spec_t *spec) {
+    g->spec = *spec;
+    rng_seed(&g->rng, spec->seed);
+    g->clock = 0.0;
+    g->produced = 0;
+    g->mmpp_on = 0;
+    g->state_end = rng_exponential(&g->rng, spec->mean_off);
+
+    double total = 0.0;
+    for (int i = 0; i < spec->num_priorities; i++)
+        total += spec->priority_weights[i];
+    double acc = 0.0;
+    for (int i = 0; i < spec->num_priorities; i++) {
+        acc += total > 0 ? spec->priority_weights[i] / total
+                         : 1.0 / spec->num_priorities;
+        g->priority_cdf[i] = acc;
+    }
+    if (spec->num_priorities > 0)
+        g->priority_cdf[spec->num_priorities - 1] = 1.0;
+}
+
+static void next_arrival(generator_t *g) {
+    const gen_spec_t *s = &g->spec;
+    if (s->arrival == ARRIVAL_POISSON) {
+        g->clock += rng_exponential(&g->rng, 1.0 / s->rate);
+        return;
+    }
+
+    // MMPP de dos estados: si la llegada cae fuera del estado actual se
+    // cambia de estado y se vuelve a sortear (las exponenciales no tienen
+    // memoria)
+    for (;;) {
+        double rate = g->mmpp_on ? s->burst_rate : s->rate;
+        double t = g->clock + rng_exponential(&g->rng, 1.0 / rate);
+        if (t <= g->state_end) {
+            g->clock = t;
+            return;
+        }
+        g->clock = g->state_end;
+        g->mmpp_on = !g->mmpp_on;
+        g->state_end = g->clock +
+            rng_exponential(&g->rng, g->mmpp_on ? s->mean_on : s->mean_off);
+    }
+}
+
+// Redondea a un entero en [1, 1e9]
+static int clamp_time(double x) {
+    if (x < 1.0) return 1;
+    if (x > 1e9) return 1000000000;
+    return (int)(x + 0.5);
+}
+
+static int next_burst(generator_t *g) {
+    const gen_spec_t *s = &g->spec;
+    double x;
+    switch (s->burst) {
+        case BURST_BIMODAL:
+            x = rng_exponential(&g->rng, rng_uniform(&g->rng) <= s->long_fraction
+                                             ? s->long_mean : s->short_mean);
+            break;
+        case BURST_PARETO:
+            x = s->min * pow(rng_uniform(&g->rng), -1.0 / s->alpha);
+            break;
+        default:
+            x = rng_exponential(&g->rng, s->mean);
+            break;
+    }
+    return clamp_time(x);
+}
+
+// Reparte cpu unidades en ráfagas de CPU separadas por E/S
+static int split_bursts(generator_t *g, int cpu, int *bursts) {
+    const gen_spec_t *s = &g->spec;
+    int k = 0;
+    while (cpu > 0) {
+        int c = clamp_time(rng_exponential(&g->rng, s->io_cpu));
+        if (c > cpu || k == GEN_MAX_BURSTS - 1)
+            c = cpu;
+        bursts[k++] = c;
+        cpu -= c;
+        if (cpu > 0)
+            bursts[k++] = clamp_time(rng_exponential(&g->rng, s->io_wait));
+    }
+    return k;
+}
+
+static int next_priority(generator_t *g) {
+    double u = rng_uniform(&g->rng);
+    for (int i = 0; i < g->spec.num_priorities - 1; i++)
+        if (u <= g->priority_cdf[i])
+            return i;
+    return g->spec.num_priorities - 1;
+}
+
+int gen_next_bursts(generator_t *g, workload_record_t *rec, int *bursts,
+                    int *num_bursts) {
+    if (g->produced >= g->spec.count)
+        return 1;
+    next_arrival(g);
+    rec->pid = (int32_t)(++g->produced);
+    rec->burst_time = next_burst(g);
+    rec->priority = next_priority(g);
+
+    // Sin E/S no se sortea nada más: las cargas de siempre no cambian
+    bursts[0] = rec->burst_time;
+    *num_bursts = 1;
+    if (g->spec.io_fraction > 0 && rng_uniform(&g->rng) <= g->spec.io_fraction)
+        *num_bursts = split_bursts(g, rec->burst_time, bursts);
+
+    // El proceso entero (CPU y E/S) debe acabar antes de INT_MAX: los
+    // instantes son int y el motor usa INT_MAX como "no quedan llegadas"
+    double end = g->clock;
+    for (int k = 0; k < *num_bursts; k++)
+        end += bursts[k];
+    if (end > INT_MAX)
+        return -1;
+    rec->arrival_time = (int32_t)g->clock;
+    return 0;
+}
+
+int gen_next(generator_t *g, workload_record_t *rec) {
+    int bursts[GEN_MAX_BURSTS], num_bursts;
+    return gen_next_bursts(g, rec, bursts, &num_bursts);
+}
+
+static int time_overflow(const generator_t *g, char *err, size_t errlen) {
+    snprintf(err, errlen, "generated process %lld would run past time %d "
+             "(raise rate or lower n)", g->produced, INT_MAX);
+    return -1;
+}
+
+int generate_workload(const gen_spec_t *spec, workload_t *wl, char *err, size_t errlen) {
+    generator_t g;
+    workload_record_t r;
+    int bursts[GEN_MAX_BURSTS], num_bursts, rc;
+    gen_init(&g, spec);
+    while ((rc = gen_next_bursts(&g, &r, bursts, &num_bursts)) == 0)
+        if (workload_add_bursts(wl, r.pid, r.arrival_time, r.priority,
+                                bursts, num_bursts) != 0) {
+            snprintf(err, errlen, "out of memory generating workload");
+            return -1;
+        }
+    return rc < 0 ? time_overflow(&g, err, errlen) : 0;
+}
+
+int generate_table(const gen_spec_t *spec, proc_table_t *pt, char *err, size_t errlen) {
+    if (spec->count > INT_MAX || proc_table_init(pt, (int)spec->count) != 0) {
+        snprintf(err, errlen, "out of memory generating workload");
+        return -1;
+    }
+    generator_t g;
+    workload_record_t r;
+    int bursts[GEN_MAX_BURSTS], num_bursts;
+
+    // Con E/S las ráfagas se acumulan aparte (su número no se conoce de
+    // antemano) junto con su posición de inicio, y se copian al final
+    int *all = NULL, *first = NULL;
+    size_t len = 0, capacity = 0;
+    if (spec->io_fraction > 0) {
+        first = malloc(((size_t)pt->n + 1) * sizeof(int));
+        if (!first) {
+            proc_table_free(pt);
+            return -1;
+        }
+    }
+
+    int rc = 0, gen;
+    gen_init(&g, spec);
+    for (int i = 0; rc == 0 && (gen = gen_next_bursts(&g, &r, bursts, &num_bursts)) == 0; i++) {
+        pt->pid[i] = r.pid;
+        pt->arrival[i] = r.arrival_time;
+        pt->burst[i] = r.burst_time;
+        pt->priority[i] = r.priority;
+        pt->remaining[i] = r.burst_time;
+        pt->start[i] = pt->completion[i] = 0;
+        if (!first)
+            continue;
+        first[i] = (int)len;
+        if (num_bursts == 1)
+            continue;
+        if (len + num_bursts > capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 4096;
+            int *grown = len + num_bursts <= INT_MAX
+                ? realloc(all, capacity * sizeof(int)) : NULL;
+            if (!grown) {
+                rc = -1;
+                break;
+            }
+            all = grown;
+        }
+        memcpy(all + len, bursts, num_bursts * sizeof(int));
+        len += num_bursts;
+    }
+
+    if (rc != 0)
+        snprintf(err, errlen, "out of memory generating workload");
+    else if (gen < 0)
+        rc = time_overflow(&g, err, errlen);
+
+    if (rc == 0 && first && len > 0) {
+        first[pt->n] = (int)len;
+        rc = proc_table_init_io(pt, len);
+        if (rc != 0)
+            snprintf(err, errlen, "out of memory generating workload");
+        if (rc == 0) {
+            memcpy(pt->first, first, ((size_t)pt->n + 1) * sizeof(int));
+            memcpy(pt->bursts, all, len * sizeof(int));
+            for (int i = 0; i < pt->n; i++) {
+                pt->io[i] = 0;
+                for (int k = pt->first[i] + 1; k < pt->first[i + 1]; k += 2)
+                    pt->io[i] += pt->bursts[k];
+            }
+        }
+    }
+    free(first);
+    free(all);
+    if (rc != 0)
+        proc_table_free(pt);
+    return rc;
+}
+
+int generate_to_file(const gen_spec_t *spec, const char *filename, int binary,
+                     char *err, size_t errlen) {
+    workload_writer_t w;
+    if (workload_writer_open(&w, filename, binary, err, errlen) != 0)
+        return -1;
+    generator_t g;
+    workload_record_t r;
+    int bursts[GEN_MAX_BURSTS], num_bursts, rc;
+    gen_init(&g, spec);
+    while ((rc = gen_next_bursts(&g, &r, bursts, &num_bursts)) == 0)
+        workload_writer_add_bursts(&w, r.pid, r.arrival_time, r.priority,
+                                   bursts, num_bursts);
+    if (workload_writer_close(&w, err, errlen) != 0)
+        return -1;
+    if (rc < 0) {
+        remove(filename);
+        return time_overflow(&g, err, errlen);
+    }
+    return 0;
+}
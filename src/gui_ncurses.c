@@ -4,7 +4,7 @@
  * Terminal UI using ncurses for the CPU Scheduler Simulator.
  *
  * Controls:
- *   r - Run simulation
+ *   r - Run simulation (animated; c cancels it)
  *   t - Cycle algorithm (FIFO -> SJF -> STCF -> RR -> MLFQ)
  *   q - Quit
  *   a - Add process (interactive)
@@ -12,9 +12,33 @@
  *   s - Save workload to file (interactive)
  *   l - Load workload from file (interactive)
  *   + / - - increase / decrease quantum (for RR)
+ *   z / Z - zoom the Gantt chart in / out
+ *   Left / Right - pan the Gantt chart
+ *   f - fit the whole run in the Gantt chart
+ *   Up / Down / PgUp / PgDn / Home / End - scroll the process table
  *
- * Note: Gantt is simplified: for preemptive algorithms it draws from first start to completion.
- * To show exact preemptive segments, algorithms must populate timeline_event_t consistently per time.
+ * The workload lives in a resim_t (resim.h): after adding or deleting a
+ * process, `r` resumes the simulation from the last checkpoint before the
+ * edited arrival instead of starting again from time 0.
+ *
+ * Runs are simulated on a background thread (pool_thread_start) so the
+ * terminal never freezes: the worker steps the resim in chunks and
+ * publishes the new timeline slices and a progress snapshot after each one
+ * through lock-free single-producer/single-consumer rings (spsc.h).  The
+ * UI polls keys with a timeout of one frame, drains the rings and redraws
+ * the growing Gantt chart, the ready-queue depth and the running metrics.
+ * While the worker runs it owns rs: the UI only reads the process inputs.
+ *
+ * The Gantt chart draws the real per-slice timeline.  The UI keeps its own
+ * copy (the worker's one is off limits while it runs) and an interval
+ * index over it (gantt.h), so each screen column is one O(log n) query and
+ * a redraw costs the terminal width whatever the zoom and run length.
+ *
+ * The screen is a set of persistent windows (panels).  Whatever changes
+ * state marks the panels it affects as dirty, and render() redraws only
+ * those with wnoutrefresh() and a single doupdate(): the quantum key
+ * repaints the controls, an idle frame repaints nothing, and the process
+ * table formats only the rows it shows.
  */
 
 #include <stdio.h>
@@ -22,21 +46,68 @@
 #include <string.h>
 #include <ncurses.h>
 #include <ctype.h>
+#include <limits.h>
+#include <stdarg.h>
 
 #include "../include/scheduler.h"
 #include "../include/algorithms.h"
 #include "../include/metrics.h"
-
-#define MAX_PROCESSES 128
-#define MAX_TIMELINE  10000
-
-/* Local copy of processes */
-static process_t processes[MAX_PROCESSES];
-static int proc_count = 0;
-
-/* timeline events produced by scheduler (we will build a simplified one) */
-static timeline_event_t timeline[MAX_TIMELINE];
-static int timeline_len = 0;
+#include "../include/timeline.h"
+#include "../include/workload.h"
+#include "../include/resim.h"
+#include "../include/spsc.h"
+#include "../include/pool.h"
+#include "../include/gantt.h"
+
+/* Decisions between checkpoints of the incremental simulation */
+#define CHECKPOINT_INTERVAL 256
+
+/* Workload (sorted by arrival) and results of the last run */
+static resim_t rs;
+
+/* Frames per second while a run is animated */
+#define LIVE_FPS 30
+
+/* Decisions the worker simulates between two progress snapshots */
+#define LIVE_CHUNK 4096
+
+/* Timeline slices buffered between the worker and the UI */
+#define LIVE_EVENTS (1 << 18)
+
+/* Progress of an animated run, as published by the worker */
+typedef struct {
+    int time;
+    int completed;
+    int ready;              /* Ready-queue depth */
+    int blocked;            /* Waiting on I/O */
+    long long decisions;
+    sim_totals_t totals;
+} live_progress_t;
+
+static struct {
+    int active;             /* A worker is running (UI thread only) */
+    pool_thread_t *thread;
+    spsc_t events;          /* timeline_event_t, worker -> UI */
+    spsc_t progress;        /* live_progress_t, worker -> UI */
+    int cancel;             /* UI -> worker */
+    int finished;           /* worker -> UI: no more snapshots */
+    live_progress_t last;   /* Newest snapshot received */
+    int cancelled;          /* The last run was cancelled */
+} live;
+
+/* Copy of rs.timeline, fed by the worker while it runs, and its index */
+static timeline_t timeline;
+static gantt_index_t gantt;
+
+/* Gantt viewport: the whole run, or `span` time units from `from` */
+static struct {
+    int fit;
+    long long from;
+    long long span;
+} view = { 1, 0, 1 };
+
+/* Narrowest viewport, in time units */
+#define MIN_SPAN 8
 
 /* Metrics */
 static metrics_t last_metrics;
@@ -51,13 +122,42 @@ static int mlfq_num_queues = 3;
 static int mlfq_quantums_default[3] = {2, 4, 8};
 static mlfq_config_t mlfq_config;
 
+/* Screen panels: persistent windows, redrawn only when marked dirty */
+enum {
+    PANEL_TABLE, PANEL_CONTROLS, PANEL_GANTT, PANEL_METRICS,
+    PANEL_STATUS, PANEL_FOOTER, PANEL_COUNT
+};
+
+static struct {
+    WINDOW *win;            /* NULL if it does not fit on the screen */
+    int dirty;
+} panels[PANEL_COUNT];
+
+/* Fixed panel heights on the right-hand side */
+#define CONTROLS_ROWS 9
+#define GANTT_ROWS 7
+
+/* First process shown in the table */
+static int table_top;
+
+/* One-line message under the panels, until the next key */
+static char status[256];
+
 /* Helpers */
-static void draw_borders();
-static void draw_process_table(int starty, int startx, int h, int w);
-static void draw_controls(int starty, int startx);
-static void draw_gantt(int starty, int startx, int h, int w);
-static void draw_metrics(int starty, int startx, int h, int w);
+static void layout();
+static void render();
+static void mark_dirty(int panel);
+static void set_status(const char *fmt, ...);
+static void draw_process_table(WINDOW *win);
+static void draw_controls(WINDOW *win);
+static void draw_gantt(WINDOW *win);
+static void draw_metrics(WINDOW *win);
+static void draw_status(WINDOW *win);
+static void draw_footer(WINDOW *win);
 static void run_selected_scheduler();
+static void live_poll();
+static void live_drain();
+static void live_cancel();
 static void clear_timeline();
 static int get_max_completion();
 static void save_workload(const char *filename);
@@ -65,159 +165,319 @@ static int load_workload(const char *filename);
 static int prompt_number(const char *prompt, int minv, int maxv);
 static void prompt_string(const char *prompt, char *buf, int maxlen);
 
-/* Utility: find process index by pid */
-static int find_proc_index_by_pid(int pid) {
-    for (int i = 0; i < proc_count; ++i)
-        if (processes[i].pid == pid) return i;
-    return -1;
-}
-
-/* Draw UI frame */
-static void draw_ui() {
+static void (*const panel_draw[PANEL_COUNT])(WINDOW *) = {
+    [PANEL_TABLE] = draw_process_table,
+    [PANEL_CONTROLS] = draw_controls,
+    [PANEL_GANTT] = draw_gantt,
+    [PANEL_METRICS] = draw_metrics,
+    [PANEL_STATUS] = draw_status,
+    [PANEL_FOOTER] = draw_footer,
+};
+
+/* (Re)create the panels for the current terminal size.  stdscr only holds
+ * the outer border: it is drawn here and never touched again, so the
+ * implicit refresh in getch() has nothing to repaint */
+static void layout() {
     int rows, cols;
     getmaxyx(stdscr, rows, cols);
-    clear();
-    draw_borders();
-
     int left_w = cols * 55 / 100;
+    int right_x = left_w + 2;
     int right_w = cols - left_w - 3;
-    int header_h = 3;
+    int gantt_y = 1 + CONTROLS_ROWS;
+    int metrics_y = gantt_y + GANTT_ROWS;
+    const int geo[PANEL_COUNT][4] = {       /* h, w, y, x */
+        [PANEL_TABLE] = { rows - 3, left_w, 1, 1 },
+        [PANEL_CONTROLS] = { CONTROLS_ROWS, right_w, 1, right_x },
+        [PANEL_GANTT] = { GANTT_ROWS, right_w, gantt_y, right_x },
+        [PANEL_METRICS] = { rows - 2 - metrics_y, right_w, metrics_y, right_x },
+        [PANEL_STATUS] = { 1, cols - 2, rows - 2, 1 },
+        [PANEL_FOOTER] = { 1, cols - 2, rows - 1, 1 },
+    };
+
+    erase();
+    box(stdscr, 0, 0);
+    mvprintw(0, 2, " CPU Scheduler Simulator (ncurses) ");
+    wnoutrefresh(stdscr);
+
+    for (int p = 0; p < PANEL_COUNT; ++p) {
+        if (panels[p].win)
+            delwin(panels[p].win);
+        /* newwin() takes a height or width of 0 as "up to the edge" */
+        panels[p].win = geo[p][0] > 0 && geo[p][1] > 0 && geo[p][2] + geo[p][0] <= rows
+                        ? newwin(geo[p][0], geo[p][1], geo[p][2], geo[p][3]) : NULL;
+        panels[p].dirty = 1;
+    }
+}
 
-    draw_process_table(1, 1, rows - header_h - 2, left_w);
-    draw_controls(1, left_w + 2);
-    draw_gantt(header_h + 1, left_w + 2, rows/2 - 2, right_w);
-    draw_metrics(header_h + rows/2 - 1, left_w + 2, rows - (header_h + rows/2 - 1) - 2, right_w);
+static void mark_dirty(int panel) {
+    panels[panel].dirty = 1;
+}
 
-    mvprintw(rows-1, 1, "r:Run  t:ChangeAlg  a:Add  d:Delete  s:Save  l:Load  +/-:Quantum  q:Quit");
-    refresh();
+/* Redraw the dirty panels and push them to the terminal in one update;
+ * curses then sends only the cells that actually changed */
+static void render() {
+    for (int p = 0; p < PANEL_COUNT; ++p) {
+        WINDOW *win = panels[p].win;
+        if (!panels[p].dirty || !win)
+            continue;
+        werase(win);
+        panel_draw[p](win);
+        wnoutrefresh(win);
+        panels[p].dirty = 0;
+    }
+    doupdate();
 }
 
-/* Draw box around main UI */
-static void draw_borders() {
-    int rows, cols;
-    getmaxyx(stdscr, rows, cols);
-    box(stdscr, 0, 0);
-    mvprintw(0, 2, " CPU Scheduler Simulator (ncurses) ");
+static void set_status(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(status, sizeof(status), fmt, ap);
+    va_end(ap);
+    mark_dirty(PANEL_STATUS);
+}
+
+static void draw_status(WINDOW *win) {
+    mvwprintw(win, 0, 1, "%s", status);
+}
+
+/* Key help, over the bottom border */
+static void draw_footer(WINDOW *win) {
+    mvwhline(win, 0, 0, ACS_HLINE, getmaxx(win));
+    if (live.active)
+        mvwprintw(win, 0, 0, "Running...  c:Cancel  z/Z,Left/Right,f:View  Up/Down,PgUp/PgDn:Scroll  q:Quit");
+    else
+        mvwprintw(win, 0, 0, "r:Run  t:ChangeAlg  a:Add  d:Delete  s:Save  l:Load  +/-:Quantum  PgUp/PgDn:Scroll  q:Quit");
+}
+
+/* Process rows that fit in the table */
+static int table_rows() {
+    WINDOW *win = panels[PANEL_TABLE].win;
+    int visible = win ? getmaxy(win) - 3 : 1;
+    return visible > 0 ? visible : 1;
+}
+
+/* Keep table_top inside the workload */
+static void clamp_table() {
+    int max_top = rs.pt.n - table_rows();
+    if (table_top > max_top) table_top = max_top;
+    if (table_top < 0) table_top = 0;
 }
 
-/* Process table */
-static void draw_process_table(int starty, int startx, int h, int w) {
-    WINDOW *win = newwin(h, w, starty, startx);
+/* Scrolling keys for the process table; returns 1 if ch was one of them */
+static int table_key(int ch) {
+    int top = table_top;
+    switch (ch) {
+        case KEY_UP:
+            table_top--;
+            break;
+        case KEY_DOWN:
+            table_top++;
+            break;
+        case KEY_PPAGE:
+            table_top -= table_rows();
+            break;
+        case KEY_NPAGE:
+            table_top += table_rows();
+            break;
+        case KEY_HOME:
+            table_top = 0;
+            break;
+        case KEY_END:
+            table_top = rs.pt.n;
+            break;
+        default:
+            return 0;
+    }
+    clamp_table();
+    if (table_top != top)
+        mark_dirty(PANEL_TABLE);
+    return 1;
+}
+
+/* Process table: only the visible rows are formatted, whatever the size of
+ * the workload */
+static void draw_process_table(WINDOW *win) {
+    int h = getmaxy(win);
+    const proc_table_t *pt = &rs.pt;
+    clamp_table();
     box(win, 0, 0);
-    mvwprintw(win, 0, 2, " Processes (%d) ", proc_count);
+    if (pt->n > table_rows())
+        mvwprintw(win, 0, 2, " Processes %d-%d of %d ", table_top + 1,
+                  table_top + table_rows() < pt->n ? table_top + table_rows() : pt->n, pt->n);
+    else
+        mvwprintw(win, 0, 2, " Processes (%d) ", pt->n);
     mvwprintw(win, 1, 1, " PID | Arrival | Burst | Pri | Rem | Start | Complete ");
     int row = 2;
-    for (int i = 0; i < proc_count && row < h-1; ++i, ++row) {
-        process_t *p = &processes[i];
-        mvwprintw(win, row, 1, " %3d | %7d | %5d | %3d | %3d | %5d | %8d ",
-                  p->pid, p->arrival_time, p->burst_time, p->priority,
-                  p->remaining_time, p->start_time, p->completion_time);
+    for (int i = table_top; i < pt->n && row < h-1; ++i, ++row) {
+        /* completion 0 = not simulated yet (added since the last run, or
+         * the run was cancelled); results are the worker's while it runs */
+        if (live.active || pt->completion[i] == 0)
+            mvwprintw(win, row, 1, " %3d | %7d | %5d | %3d | %3d | %5s | %8s ",
+                      pt->pid[i], pt->arrival[i], pt->burst[i], pt->priority[i],
+                      pt->burst[i], "-", "-");
+        else
+            mvwprintw(win, row, 1, " %3d | %7d | %5d | %3d | %3d | %5d | %8d ",
+                      pt->pid[i], pt->arrival[i], pt->burst[i], pt->priority[i],
+                      pt->remaining[i], pt->start[i], pt->completion[i]);
     }
-    wrefresh(win);
-    delwin(win);
 }
 
 /* Controls: show selected algorithm and quantum */
-static void draw_controls(int starty, int startx) {
-    int y = starty;
-    mvprintw(y++, startx, "Algorithm:");
+static void draw_controls(WINDOW *win) {
+    int y = 0;
+    mvwprintw(win, y++, 0, "Algorithm:");
     const char *names[ALG_COUNT] = { "FIFO", "SJF", "STCF", "RR", "MLFQ" };
     for (int i = 0; i < ALG_COUNT; ++i) {
-        if (i == curr_alg) attron(A_REVERSE);
-        mvprintw(y++, startx, " %s", names[i]);
-        if (i == curr_alg) attroff(A_REVERSE);
+        if (i == curr_alg) wattron(win, A_REVERSE);
+        mvwprintw(win, y++, 0, " %s", names[i]);
+        if (i == curr_alg) wattroff(win, A_REVERSE);
     }
-    mvprintw(y++, startx, "Quantum (RR): %d", rr_quantum);
-    mvprintw(y++, startx, "MLFQ queues: %d", mlfq_num_queues);
-    mvprintw(y++, startx, "MLFQ quantums: ");
+    mvwprintw(win, y++, 0, "Quantum (RR): %d", rr_quantum);
+    mvwprintw(win, y++, 0, "MLFQ queues: %d", mlfq_num_queues);
+    mvwprintw(win, y++, 0, "MLFQ quantums: ");
     for (int i = 0; i < mlfq_num_queues; ++i) {
-        printw("%d ", mlfq_config.quantums[i]);
+        wprintw(win, "%d ", mlfq_config.quantums[i]);
     }
 }
 
-/* Build simplified timeline from process start & completion */
-static void build_simplified_timeline_from_processes() {
-    clear_timeline();
-    int idx = 0;
-    for (int i = 0; i < proc_count; ++i) {
-        process_t *p = &processes[i];
-        if (p->completion_time <= p->start_time) continue;
-        timeline[idx].time = p->start_time;
-        timeline[idx].pid = p->pid;
-        timeline[idx].duration = p->completion_time - p->start_time;
-        idx++;
-        if (idx >= MAX_TIMELINE) break;
+/* Time covered by the timeline copy */
+static void timeline_bounds(long long *min_t, long long *max_t) {
+    const timeline_event_t *last = &timeline.events[timeline.count - 1];
+    *min_t = timeline.events[0].time;
+    *max_t = (long long)last->time + last->duration;
+}
+
+/* Keep the viewport inside the run (it follows the run while fitting) */
+static void clamp_view(long long min_t, long long max_t) {
+    long long total = max_t - min_t > 0 ? max_t - min_t : 1;
+    if (view.fit || view.span >= total) {
+        view.fit = 1;
+        view.from = min_t;
+        view.span = total;
+        return;
+    }
+    if (view.span < MIN_SPAN) view.span = MIN_SPAN;
+    if (view.from + view.span > max_t) view.from = max_t - view.span;
+    if (view.from < min_t) view.from = min_t;
+}
+
+/* Zoom and pan keys; returns 1 if ch was one of them */
+static int gantt_key(int ch) {
+    if (ch != 'z' && ch != 'Z' && ch != 'f' && ch != KEY_LEFT && ch != KEY_RIGHT)
+        return 0;
+    if (timeline.count == 0)
+        return 1;
+    long long min_t, max_t;
+    timeline_bounds(&min_t, &max_t);
+    clamp_view(min_t, max_t);
+    long long center = view.from + view.span / 2;
+    long long step = view.span / 4 > 0 ? view.span / 4 : 1;
+    switch (ch) {
+        case 'z':
+            view.fit = 0;
+            view.span /= 2;
+            view.from = center - view.span / 2;
+            break;
+        case 'Z':
+            view.span *= 2;
+            view.from = center - view.span / 2;
+            break;
+        case 'f':
+            view.fit = 1;
+            break;
+        case KEY_LEFT:
+            view.fit = 0;
+            view.from -= step;
+            break;
+        case KEY_RIGHT:
+            view.fit = 0;
+            view.from += step;
+            break;
     }
-    timeline_len = idx;
+    clamp_view(min_t, max_t);
+    mark_dirty(PANEL_GANTT);
+    return 1;
 }
 
-/* Draw a very simple Gantt chart */
-static void draw_gantt(int starty, int startx, int h, int w) {
-    WINDOW *win = newwin(h, w, starty, startx);
+/* Gantt chart: one index query per column, whatever the number of slices */
+static void draw_gantt(WINDOW *win) {
+    int w = getmaxx(win);
     box(win, 0, 0);
-    mvwprintw(win, 0, 2, " Gantt Chart ");
 
-    if (timeline_len == 0) {
-        mvwprintw(win, 2, 2, "No timeline. Run the scheduler (r).");
-        wrefresh(win);
-        delwin(win);
+    if (timeline.count == 0) {
+        mvwprintw(win, 0, 2, " Gantt Chart ");
+        mvwprintw(win, 2, 2, live.active ? "Simulating..." :
+                  "No timeline. Run the scheduler (r).");
         return;
     }
 
-    /* Determine span */
-    int min_t = timeline[0].time;
-    int max_t = timeline[0].time + timeline[0].duration;
-    for (int i = 1; i < timeline_len; ++i) {
-        if (timeline[i].time < min_t) min_t = timeline[i].time;
-        int endt = timeline[i].time + timeline[i].duration;
-        if (endt > max_t) max_t = endt;
-    }
-    int span = max_t - min_t;
-    if (span <= 0) span = 1;
+    long long min_t, max_t;
+    timeline_bounds(&min_t, &max_t);
+    clamp_view(min_t, max_t);
+    mvwprintw(win, 0, 2, " Gantt Chart %s", view.fit ? "(all) " : "(zoomed) ");
 
     int gantt_y = 2;
-    int gantt_h = 3;
     int gantt_w = w - 4;
-    int px_per_unit = gantt_w / span;
-    if (px_per_unit < 1) px_per_unit = 1;
-
-    /* Draw time scale */
-    for (int i = 0; i < timeline_len; ++i) {
-        int rel = timeline[i].time - min_t;
-        int x = 2 + rel * px_per_unit;
-        int block_w = timeline[i].duration * px_per_unit;
-        if (x + block_w > 2 + gantt_w) block_w = 2 + gantt_w - x;
-        if (block_w <= 0) continue;
-        /* show pid label centered */
-        char label[16];
-        snprintf(label, sizeof(label), "P%d", timeline[i].pid);
-        int label_pos = x + block_w/2 - (int)strlen(label)/2;
-        if (label_pos < 2) label_pos = 2;
-        for (int c = 0; c < block_w; ++c) {
-            mvwaddch(win, gantt_y, x + c, ACS_CKBOARD);
+    int prev = -1, alt = 0, label_end = 0;
+    for (int c = 0; c < gantt_w; ++c) {
+        /* Column c covers [a, b); zoomed in, several columns share a unit */
+        long long a = view.from + view.span * c / gantt_w;
+        long long b = view.from + view.span * (c + 1) / gantt_w;
+        if (b <= a) b = a + 1;
+        gantt_column_t col = gantt_query(&gantt, &timeline, a, b);
+        if (col.pid < 0) {
+            prev = -1;
+            continue;
         }
-        mvwprintw(win, gantt_y+1, label_pos, "%s", label);
-
-        /* times below */
-        mvwprintw(win, gantt_y+2, x, "%d", timeline[i].time);
+        /* Alternate the fill on every change so neighbours stay apart */
+        if (col.pid != prev) {
+            alt = !alt;
+            char label[16];
+            int len = snprintf(label, sizeof(label), "P%d", col.pid);
+            if (c >= label_end && c + len <= gantt_w) {
+                mvwprintw(win, gantt_y+1, 2 + c, "%s", label);
+                label_end = c + len + 1;
+            }
+        }
+        /* Mostly idle columns are drawn lighter */
+        chtype fill = 2 * col.busy >= b - a ? (alt ? ACS_CKBOARD : ACS_BLOCK) : '.';
+        mvwaddch(win, gantt_y, 2 + c, fill);
+        prev = col.pid;
     }
-    /* draw final maximum time at end */
-    mvwprintw(win, gantt_y+2, 2 + gantt_w - 4, "%d", max_t);
 
-    wrefresh(win);
-    delwin(win);
+    /* Time axis: both ends of the viewport */
+    char end[24];
+    int len = snprintf(end, sizeof(end), "%lld", view.from + view.span);
+    mvwprintw(win, gantt_y+2, 2, "%lld", view.from);
+    mvwprintw(win, gantt_y+2, 2 + gantt_w - len, "%s", end);
+    mvwprintw(win, gantt_y+3, 2, "z/Z:Zoom  Left/Right:Pan  f:Fit");
 }
 
 /* Metrics display */
-static void draw_metrics(int starty, int startx, int h, int w) {
-    WINDOW *win = newwin(h, w, starty, startx);
+static void draw_metrics(WINDOW *win) {
     box(win, 0, 0);
     mvwprintw(win, 0, 2, " Metrics ");
 
-    if (proc_count == 0) {
+    if (rs.pt.n == 0) {
         mvwprintw(win, 2, 2, "No processes.");
-        wrefresh(win);
-        delwin(win);
+        return;
+    }
+
+    /* Running (or cancelled): metrics over what has been simulated so far */
+    if (live.active || live.cancelled) {
+        const live_progress_t *p = &live.last;
+        double t = p->time > 0 ? p->time : 1;
+        mvwprintw(win, 2, 2, "%s t=%d", live.active ? "Running:" : "Cancelled at", p->time);
+        mvwprintw(win, 3, 2, "Completed:      %d / %d", p->completed, rs.pt.n);
+        mvwprintw(win, 4, 2, "Ready queue:    %d", p->ready);
+        mvwprintw(win, 5, 2, "Blocked (I/O):  %d", p->blocked);
+        mvwprintw(win, 6, 2, "Avg Turnaround: %.2f", p->completed > 0 ?
+                  (double)p->totals.turnaround / p->completed : 0.0);
+        mvwprintw(win, 7, 2, "Avg Response:   %.2f", p->totals.started > 0 ?
+                  (double)p->totals.response / p->totals.started : 0.0);
+        mvwprintw(win, 8, 2, "CPU Utilization: %.2f %%", 100.0 * p->totals.busy / t);
+        mvwprintw(win, 9, 2, "Throughput:     %.4f p/u", p->completed / t);
+        mvwprintw(win, 10, 2, "Decisions:      %lld", p->decisions);
         return;
     }
 
@@ -227,196 +487,270 @@ static void draw_metrics(int starty, int startx, int h, int w) {
     mvwprintw(win, 5, 2, "CPU Utilization: %.2f %%", last_metrics.cpu_utilization);
     mvwprintw(win, 6, 2, "Throughput:     %.4f p/u", last_metrics.throughput);
     mvwprintw(win, 7, 2, "Fairness (Jain): %.4f", last_metrics.fairness_index);
-
-    wrefresh(win);
-    delwin(win);
+    mvwprintw(win, 8, 2, "Response p50/p99: %d / %d",
+              last_metrics.response.p50, last_metrics.response.p99);
+    mvwprintw(win, 9, 2, "Waiting  p99/max: %d / %d",
+              last_metrics.waiting.p99, last_metrics.waiting.max);
+    /* How much of the last run was actually simulated */
+    mvwprintw(win, 10, 2, "Last run: from t=%d, %lld decisions",
+              rs.resumed_at, rs.steps);
 }
 
 /* Clear timeline events */
 static void clear_timeline() {
-    for (int i = 0; i < MAX_TIMELINE; ++i) {
-        timeline[i].time = 0;
-        timeline[i].pid = -1;
-        timeline[i].duration = 0;
-    }
-    timeline_len = 0;
+    timeline_clear(&timeline);
+    gantt_index_truncate(&gantt, 0);
+    mark_dirty(PANEL_GANTT);
 }
 
-/* Run scheduler and compute metrics */
-static void run_selected_scheduler() {
-    if (proc_count == 0) return;
+/* Worker side: every slice goes to the UI, waiting while its ring is full */
+static void live_event(void *ctx, const timeline_event_t *ev) {
+    (void)ctx;
+    spsc_push_wait(&live.events, ev, 1, &live.cancel);
+}
 
-    /* copy processes into a temporary array the schedulers can modify */
-    process_t temp[MAX_PROCESSES];
-    for (int i = 0; i < proc_count; ++i) temp[i] = processes[i];
+static void live_worker(void *ctx) {
+    (void)ctx;
+    live_progress_t p;
+    long long done;
+    do {
+        done = resim_advance(&rs, LIVE_CHUNK);
+        p.time = rs.st.sim.time;
+        p.completed = rs.st.sim.completed;
+        p.ready = sched_ready(&rs.st);
+        p.blocked = sched_blocked(&rs.st);
+        p.decisions = rs.steps;
+        p.totals = rs.st.sim.totals;
+        /* Dropped if the UI is behind: only the newest one matters */
+        spsc_push(&live.progress, &p, 1);
+    } while (done == LIVE_CHUNK && !__atomic_load_n(&live.cancel, __ATOMIC_ACQUIRE));
+    __atomic_store_n(&live.finished, 1, __ATOMIC_RELEASE);
+}
 
-    clear_timeline();
-    /* zero some fields */
-    for (int i = 0; i < proc_count; ++i) {
-        temp[i].remaining_time = temp[i].burst_time;
-        temp[i].start_time = -1;
-        temp[i].completion_time = -1;
-        temp[i].turnaround_time = 0;
-        temp[i].waiting_time = 0;
-        temp[i].response_time = -1;
-    }
+/* Results of a finished run */
+static void show_results() {
+    int total_time = proc_table_makespan(&rs.pt);
+    if (total_time <= 0) total_time = 1;
+    calculate_metrics_table(&rs.pt, total_time, &last_metrics);
+}
 
-    /* Call chosen algorithm */
-    switch (curr_alg) {
-        case ALG_FIFO:
-            schedule_fifo(temp, proc_count, timeline);
-            break;
-        case ALG_SJF:
-            schedule_sjf(temp, proc_count, timeline);
-            break;
-        case ALG_STCF:
-            schedule_stcf(temp, proc_count, timeline);
-            break;
-        case ALG_RR:
-            schedule_rr(temp, proc_count, rr_quantum, timeline);
-            break;
-        case ALG_MLFQ:
-            mlfq_config.num_queues = mlfq_num_queues;
-            mlfq_config.quantums = mlfq_quantums_default; /* simplified */
-            mlfq_config.boost_interval = 50;
-            schedule_mlfq(temp, proc_count, &mlfq_config, timeline);
-            break;
-        default:
-            break;
+/* Panels that change when a run starts or stops */
+static void mark_run_dirty() {
+    mark_dirty(PANEL_TABLE);
+    mark_dirty(PANEL_GANTT);
+    mark_dirty(PANEL_METRICS);
+    mark_dirty(PANEL_FOOTER);
+}
+
+/* Worker is done: take rs back */
+static void live_stop() {
+    pool_thread_join(live.thread);
+    live.active = 0;
+    live_drain();
+    int rc = resim_end(&rs);
+    live.cancelled = rc != 1;
+    if (rc < 0)
+        set_status("Out of memory simulating.");
+    else if (rc)
+        show_results();
+    spsc_free(&live.events);
+    spsc_free(&live.progress);
+    timeout(-1);
+    mark_run_dirty();
+}
+
+/* Move what the worker published into the timeline copy and its index */
+static void live_drain() {
+    timeline_event_t evs[1024];
+    size_t k, total = 0;
+    for (; total < LIVE_EVENTS &&
+         (k = spsc_pop(&live.events, evs, 1024)) > 0; total += k)
+        for (size_t i = 0; i < k; i++)
+            timeline_append_event(&timeline, &evs[i]);
+    if (total > 0) {
+        gantt_index_update(&gantt, &timeline);
+        mark_dirty(PANEL_GANTT);
     }
+    /* An idle frame redraws nothing */
+    while (spsc_pop(&live.progress, &live.last, 1) > 0)
+        mark_dirty(PANEL_METRICS);
+}
+
+/* UI side, once per frame */
+static void live_poll() {
+    live_drain();
+    if (live.active && __atomic_load_n(&live.finished, __ATOMIC_ACQUIRE))
+        live_stop();
+}
+
+static void live_cancel() {
+    __atomic_store_n(&live.cancel, 1, __ATOMIC_RELEASE);
+    live_stop();
+}
 
-    /* After scheduling, compute total_time: use max completion_time if available */
-    int total_time = 0;
-    for (int i = 0; i < proc_count; ++i) {
-        if (temp[i].completion_time > total_time) total_time = temp[i].completion_time;
-        if (temp[i].completion_time <= 0) {
-            /* fallback: sum bursts */
-            total_time += temp[i].burst_time;
+/* Run scheduler and compute metrics */
+static void run_selected_scheduler() {
+    if (rs.pt.n == 0) return;
+
+    mlfq_config.num_queues = mlfq_num_queues;
+    mlfq_config.quantums = mlfq_quantums_default; /* simplified */
+    mlfq_config.boost_interval = 50;
+    resim_set_policy(&rs, (sched_alg_t)curr_alg, rr_quantum, &mlfq_config);
+
+    static timeline_sink_t tap = { live_event, NULL, NULL };
+    if (spsc_init(&live.events, sizeof(timeline_event_t), LIVE_EVENTS) != 0 ||
+        spsc_init(&live.progress, sizeof(live_progress_t), 64) != 0 ||
+        resim_begin(&rs, &tap) != 0) {
+        spsc_free(&live.events);
+        spsc_free(&live.progress);
+        set_status("Out of memory simulating.");
+        return;
+    }
+    mark_run_dirty();
+    live.cancelled = 0;
+    live.cancel = 0;
+    live.finished = 0;
+    live.last = (live_progress_t){ .time = rs.resumed_at };
+
+    /* The worker only sends what it simulates: the copy is cut where the
+     * resim resumed, like rs.timeline.  With nothing edited the copy and
+     * its index are already those of the last run */
+    if (rs.running) {
+        timeline_truncate(&timeline, rs.resumed_at);
+        if (timeline.count != rs.timeline.count) {
+            clear_timeline();
+            for (int i = 0; i < rs.timeline.count; ++i)
+                timeline_append_event(&timeline, &rs.timeline.events[i]);
         }
+        gantt_index_truncate(&gantt, timeline.count);
     }
-    if (total_time <= 0) total_time = 1;
 
-    /* Calculate metrics */
-    calculate_metrics(temp, proc_count, total_time, &last_metrics);
-
-    /* Copy back some fields to main processes array for display (start/completion) */
-    for (int i = 0; i < proc_count; ++i) {
-        int pid = temp[i].pid;
-        int idx = find_proc_index_by_pid(pid);
-        if (idx >= 0) {
-            processes[idx].start_time = temp[i].start_time;
-            processes[idx].completion_time = temp[i].completion_time;
-            processes[idx].remaining_time = temp[i].remaining_time;
-            processes[idx].turnaround_time = temp[i].turnaround_time;
-            processes[idx].waiting_time = temp[i].waiting_time;
-            processes[idx].response_time = temp[i].response_time;
-        }
+    live.thread = rs.running ? pool_thread_start(live_worker, NULL) : NULL;
+    if (live.thread) {
+        live.active = 1;
+        timeout(1000 / LIVE_FPS);
+        return;
     }
 
-    /* Build simplified timeline from start/completion */
-    build_simplified_timeline_from_processes();
+    /* Nothing to simulate, or no thread: finish here */
+    while (resim_advance(&rs, LIVE_CHUNK) == LIVE_CHUNK)
+        live_drain();
+    live_drain();
+    int rc = resim_end(&rs);
+    spsc_free(&live.events);
+    spsc_free(&live.progress);
+    if (rc < 0)
+        set_status("Out of memory simulating.");
+    else
+        show_results();
 }
 
-/* Prompt helpers (blocking) */
+/* Prompt helpers (blocking), on the status line */
 static int prompt_number(const char *prompt, int minv, int maxv) {
-    echo();
-    curs_set(1);
     char buf[64];
-    mvprintw(LINES-3, 2, "%s ", prompt);
-    clrtoeol();
-    getnstr(buf, sizeof(buf)-1);
+    prompt_string(prompt, buf, sizeof(buf));
     int val = atoi(buf);
     if (val < minv) val = minv;
     if (maxv >= minv && val > maxv) val = maxv;
-    noecho();
-    curs_set(0);
     return val;
 }
 
 static void prompt_string(const char *prompt, char *buf, int maxlen) {
+    WINDOW *win = panels[PANEL_STATUS].win;
+    buf[0] = '\0';
+    if (!win)
+        return;
+    werase(win);
+    mvwprintw(win, 0, 1, "%s ", prompt);
     echo();
     curs_set(1);
-    mvprintw(LINES-3, 2, "%s ", prompt);
-    clrtoeol();
-    getnstr(buf, maxlen-1);
+    wgetnstr(win, buf, maxlen-1);
     noecho();
     curs_set(0);
+    mark_dirty(PANEL_STATUS);
 }
 
-/* Save workload: one process per line: pid arrival burst priority */
+/* Save workload: one process per line: pid arrival burst priority [io burst]... */
 static void save_workload(const char *filename) {
-    FILE *f = fopen(filename, "w");
-    if (!f) {
-        mvprintw(LINES-4, 2, "Error saving to '%s'", filename);
+    const proc_table_t *pt = &rs.pt;
+    workload_writer_t w;
+    char err[256];
+    if (workload_writer_open(&w, filename, 0, err, sizeof(err)) != 0) {
+        set_status("%s", err);
         return;
     }
-    for (int i = 0; i < proc_count; ++i) {
-        process_t *p = &processes[i];
-        fprintf(f, "%d %d %d %d\n", p->pid, p->arrival_time, p->burst_time, p->priority);
+    for (int i = 0; i < pt->n; ++i) {
+        if (pt->first && pt->first[i + 1] > pt->first[i])
+            workload_writer_add_bursts(&w, pt->pid[i], pt->arrival[i], pt->priority[i],
+                                       pt->bursts + pt->first[i],
+                                       pt->first[i + 1] - pt->first[i]);
+        else
+            workload_writer_add(&w, pt->pid[i], pt->arrival[i], pt->burst[i],
+                                pt->priority[i]);
     }
-    fclose(f);
-    mvprintw(LINES-4, 2, "Saved to '%s' (%d processes)", filename, proc_count);
+    if (workload_writer_close(&w, err, sizeof(err)) != 0) {
+        set_status("%s", err);
+        return;
+    }
+    set_status("Saved to '%s' (%d processes)", filename, pt->n);
 }
 
-/* Load workload: returns number loaded or -1 on error */
+/* Load workload (text or binary): returns number loaded or -1 on error */
 static int load_workload(const char *filename) {
-    FILE *f = fopen(filename, "r");
-    if (!f) {
-        mvprintw(LINES-4, 2, "Error opening '%s'", filename);
+    workload_t wl;
+    char err[256];
+    workload_init(&wl);
+    if (workload_load(filename, &wl, err, sizeof(err)) != 0) {
+        set_status("%s", err);
+        workload_free(&wl);
         return -1;
     }
-    proc_count = 0;
-    while (!feof(f) && proc_count < MAX_PROCESSES) {
-        int pid, arrival, burst, priority;
-        int ret = fscanf(f, "%d %d %d %d", &pid, &arrival, &burst, &priority);
-        if (ret != 4) break;
-        process_t p;
-        p.pid = pid;
-        p.arrival_time = arrival;
-        p.burst_time = burst;
-        p.priority = priority;
-        p.remaining_time = burst;
-        p.start_time = -1;
-        p.completion_time = -1;
-        processes[proc_count++] = p;
+    if (resim_load(&rs, wl.processes, wl.n) != 0) {
+        set_status("Out of memory loading '%s'", filename);
+        workload_free(&wl);
+        return -1;
     }
-    fclose(f);
-    mvprintw(LINES-4, 2, "Loaded %d processes from '%s'    ", proc_count, filename);
-    return proc_count;
+    workload_free(&wl);
+    timeline_clear(&rs.timeline);
+    clear_timeline();
+    live.cancelled = 0;
+    mark_dirty(PANEL_TABLE);
+    mark_dirty(PANEL_METRICS);
+    set_status("Loaded %d processes from '%s'", rs.pt.n, filename);
+    return rs.pt.n;
 }
 
 /* Interactive add process */
 static void add_process_interactive() {
-    int pid = prompt_number("PID:", 1, 999999);
-    int arrival = prompt_number("Arrival time:", 0, 1000000);
-    int burst = prompt_number("Burst time:", 1, 1000000);
-    int priority = prompt_number("Priority (lower=more):", 0, 1000);
-
-    if (proc_count >= MAX_PROCESSES) {
-        mvprintw(LINES-4, 2, "Max processes reached.");
+    process_t p = {0};
+    p.pid = prompt_number("PID:", 1, 999999);
+    p.arrival_time = prompt_number("Arrival time:", 0, 1000000);
+    p.burst_time = prompt_number("Burst time:", 1, 1000000);
+    p.priority = prompt_number("Priority (lower=more):", 0, 1000);
+
+    if (resim_add(&rs, &p) < 0) {
+        set_status("Out of memory adding PID %d.", p.pid);
         return;
     }
-    processes[proc_count].pid = pid;
-    processes[proc_count].arrival_time = arrival;
-    processes[proc_count].burst_time = burst;
-    processes[proc_count].priority = priority;
-    processes[proc_count].remaining_time = burst;
-    processes[proc_count].start_time = -1;
-    processes[proc_count].completion_time = -1;
-    proc_count++;
+    mark_dirty(PANEL_TABLE);
+    mark_dirty(PANEL_METRICS);
 }
 
 /* Interactive delete by PID */
 static void delete_process_interactive() {
     int pid = prompt_number("Delete PID:", 1, 999999);
-    int idx = find_proc_index_by_pid(pid);
+    int idx = resim_find(&rs, pid);
     if (idx < 0) {
-        mvprintw(LINES-4, 2, "PID %d not found.", pid);
+        set_status("PID %d not found.", pid);
+        return;
+    }
+    if (resim_remove(&rs, idx) != 0) {
+        set_status("Out of memory deleting PID %d.", pid);
         return;
     }
-    for (int i = idx; i < proc_count-1; ++i) processes[i] = processes[i+1];
-    proc_count--;
-    mvprintw(LINES-4, 2, "Deleted PID %d.", pid);
+    mark_dirty(PANEL_TABLE);
+    mark_dirty(PANEL_METRICS);
+    set_status("Deleted PID %d.", pid);
 }
 
 /* Main loop */
@@ -427,10 +761,15 @@ int main(int argc, char **argv) {
     mlfq_config.boost_interval = 50;
 
     /* Example initial processes (if none loaded) */
-    processes[0].pid = 1; processes[0].arrival_time = 0; processes[0].burst_time = 5; processes[0].priority = 1;
-    processes[1].pid = 2; processes[1].arrival_time = 1; processes[1].burst_time = 3; processes[1].priority = 2;
-    processes[2].pid = 3; processes[2].arrival_time = 2; processes[2].burst_time = 8; processes[2].priority = 1;
-    proc_count = 3;
+    process_t examples[3] = {
+        { .pid = 1, .arrival_time = 0, .burst_time = 5, .priority = 1 },
+        { .pid = 2, .arrival_time = 1, .burst_time = 3, .priority = 2 },
+        { .pid = 3, .arrival_time = 2, .burst_time = 8, .priority = 1 },
+    };
+    if (resim_init(&rs, CHECKPOINT_INTERVAL) != 0 || resim_load(&rs, examples, 3) != 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
 
     /* Init ncurses */
     initscr();
@@ -438,18 +777,45 @@ int main(int argc, char **argv) {
     curs_set(0);
     keypad(stdscr, TRUE);
 
-    clear_timeline();
+    timeline_init(&timeline, 256);
+    gantt_index_init(&gantt);
 
-    draw_ui();
+    layout();
+    render();
 
     int ch;
-    while ((ch = getch()) != 'q') {
+    while ((ch = getch()) != 'q' || live.active) {
+        /* A message stays up until the next key */
+        if (ch != ERR && status[0]) {
+            status[0] = '\0';
+            mark_dirty(PANEL_STATUS);
+        }
+        if (ch == KEY_RESIZE)
+            layout();
+        /* Animated run: only cancel, quit and view keys; getch times out
+         * every frame */
+        if (live.active) {
+            if (ch == 'c' || ch == 'q')
+                live_cancel();
+            else if (!gantt_key(ch))
+                table_key(ch);
+            live_poll();
+            if (ch == 'q')
+                break;
+            render();
+            continue;
+        }
+        if (gantt_key(ch) || table_key(ch)) {
+            render();
+            continue;
+        }
         switch (ch) {
             case 'r':
                 run_selected_scheduler();
                 break;
             case 't':
                 curr_alg = (curr_alg + 1) % ALG_COUNT;
+                mark_dirty(PANEL_CONTROLS);
                 break;
             case 'a':
                 add_process_interactive();
@@ -472,18 +838,26 @@ int main(int argc, char **argv) {
             case '+':
             case '=':
                 rr_quantum++;
+                mark_dirty(PANEL_CONTROLS);
                 break;
             case '-':
-                if (rr_quantum > 1) rr_quantum--;
-                break;
-            case KEY_RESIZE:
+                if (rr_quantum > 1) {
+                    rr_quantum--;
+                    mark_dirty(PANEL_CONTROLS);
+                }
                 break;
             default:
                 break;
         }
-        draw_ui();
+        render();
     }
 
+    for (int p = 0; p < PANEL_COUNT; ++p)
+        if (panels[p].win)
+            delwin(panels[p].win);
     endwin();
+    gantt_index_free(&gantt);
+    timeline_free(&timeline);
+    resim_free(&rs);
     return 0;
 }
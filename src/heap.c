@@ -0,0 +1,171 @@
+#include <stdlib.h>
+#include "heap.h"
+#include "simd.h"
+
+// El xor pasa tie a orden sin signo, así que comparar el int64 con signo
+// equivale a comparar (key, tie)
+static inline int64_t pack(int key, int tie) {
+    return (int64_t)((uint64_t)(int64_t)key << 32 | (uint32_t)(tie ^ INT32_MIN));
+}
+
+static inline void place(heap_t *h, int i, int64_t key, int idx) {
+    h->keys[i] = key;
+    h->idx[i] = idx;
+    h->pos[idx] = i;
+}
+
+static void sift_up(heap_t *h, int i) {
+    int64_t key = h->keys[i];
+    int idx = h->idx[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (key >= h->keys[parent])
+            break;
+        place(h, i, h->keys[parent], h->idx[parent]);
+        i = parent;
+    }
+    place(h, i, key, idx);
+}
+
+static void sift_down(heap_t *h, int i) {
+    int64_t key = h->keys[i];
+    int idx = h->idx[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= h->size)
+            break;
+        if (child + 1 < h->size && h->keys[child + 1] < h->keys[child])
+            child++;
+        if (h->keys[child] >= key)
+            break;
+        place(h, i, h->keys[child], h->idx[child]);
+        i = child;
+    }
+    place(h, i, key, idx);
+}
+
+static inline void find_top(heap_t *h) {
+    h->top = h->heapified || h->size == 0 ? 0 : simd_argmin_i64(h->keys, h->size);
+}
+
+int heap_init(heap_t *h, int capacity) {
+    if (capacity < 1)
+        capacity = 1;
+    h->size = 0;
+    h->capacity = capacity;
+    h->slots = capacity;
+    h->shared_pos = 0;
+    h->heapified = 0;
+    h->top = 0;
+    h->keys = malloc(capacity * sizeof(int64_t));
+    h->idx = malloc(capacity * sizeof(int));
+    h->pos = malloc(capacity * sizeof(int));
+    if (!h->keys || !h->idx || !h->pos) {
+        heap_free(h);
+        return -1;
+    }
+    for (int i = 0; i < capacity; i++)
+        h->pos[i] = -1;
+    return 0;
+}
+
+int heap_init_shared(heap_t *h, int *pos, int capacity) {
+    h->size = 0;
+    h->capacity = capacity;
+    h->slots = HEAP_FLAT_MAX;
+    h->shared_pos = 1;
+    h->heapified = 0;
+    h->top = 0;
+    h->pos = pos;
+    h->keys = malloc(h->slots * sizeof(int64_t));
+    h->idx = malloc(h->slots * sizeof(int));
+    if (!h->keys || !h->idx) {
+        heap_free(h);
+        return -1;
+    }
+    return 0;
+}
+
+void heap_free(heap_t *h) {
+    free(h->keys);
+    free(h->idx);
+    if (!h->shared_pos)
+        free(h->pos);
+    h->keys = NULL;
+    h->idx = NULL;
+    h->pos = NULL;
+    h->size = 0;
+}
+
+static int grow(heap_t *h) {
+    int slots = h->slots * 2 < h->capacity ? h->slots * 2 : h->capacity;
+    int64_t *keys = realloc(h->keys, slots * sizeof(int64_t));
+    if (!keys)
+        return -1;
+    h->keys = keys;
+    int *idx = realloc(h->idx, slots * sizeof(int));
+    if (!idx)
+        return -1;
+    h->idx = idx;
+    h->slots = slots;
+    return 0;
+}
+
+int heap_push(heap_t *h, int idx, int key, int tie) {
+    if (h->size == h->slots && grow(h) != 0)
+        return -1;
+    int i = h->size++;
+    place(h, i, pack(key, tie), idx);
+    if (h->heapified) {
+        sift_up(h, i);
+    } else if (h->size > HEAP_FLAT_MAX) {
+        for (int j = h->size / 2 - 1; j >= 0; j--)
+            sift_down(h, j);
+        h->heapified = 1;
+        h->top = 0;
+    } else if (h->keys[i] < h->keys[h->top]) {
+        h->top = i;
+    }
+    return 0;
+}
+
+int heap_pop(heap_t *h) {
+    if (h->size == 0)
+        return -1;
+    int i = h->top;
+    int idx = h->idx[i];
+    h->pos[idx] = -1;
+    if (--h->size > i) {
+        place(h, i, h->keys[h->size], h->idx[h->size]);
+        if (h->heapified)
+            sift_down(h, i);
+    }
+    // Un heap válido también es un arreglo plano válido
+    if (h->heapified && h->size <= HEAP_FLAT_MAX / 2)
+        h->heapified = 0;
+    find_top(h);
+    return idx;
+}
+
+int heap_peek(const heap_t *h) {
+    return h->size > 0 ? h->idx[h->top] : -1;
+}
+
+void heap_update(heap_t *h, int idx, int key) {
+    int i = h->pos[idx];
+    if (i < 0)
+        return;
+    int64_t old = h->keys[i];
+    h->keys[i] = (int64_t)((uint64_t)(int64_t)key << 32 | (uint32_t)old);
+    if (!h->heapified) {
+        if (h->keys[i] < h->keys[h->top])
+            h->top = i;
+        else if (i == h->top && h->keys[i] > old)
+            find_top(h);
+        return;
+    }
+    if (h->keys[i] < old)
+        sift_up(h, i);
+    else if (h->keys[i] > old)
+        sift_down(h, i);
+}
@@ -0,0 +1,72 @@
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include "histogram.h"
+
+// Mayor valor que cae en la cubeta idx
+static inline long long bucket_upper(int idx) {
+    if (idx < 2 * HIST_SUB_BUCKETS)
+        return idx;
+    int rel = idx - 2 * HIST_SUB_BUCKETS;
+    int shift = rel / HIST_SUB_BUCKETS + 1;
+    long long top = HIST_SUB_BUCKETS + rel % HIST_SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+void hist_init(hist_t *h) {
+    memset(h->counts, 0, sizeof(h->counts));
+    h->total = 0;
+    h->min = INT_MAX;
+    h->max = 0;
+}
+
+void hist_record(hist_t *h, int value) {
+    if (value < 0)
+        value = 0;
+    h->counts[hist_bucket(value)]++;
+    h->total++;
+    if (value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+}
+
+void hist_record_buckets(hist_t *h, const int *buckets, int n) {
+    for (int i = 0; i < n; i++)
+        h->counts[buckets[i]]++;
+    h->total += n;
+}
+
+void hist_add_range(hist_t *h, int min, int max) {
+    if (min < h->min) h->min = min;
+    if (max > h->max) h->max = max;
+}
+
+void hist_merge(hist_t *dst, const hist_t *src) {
+    for (int i = 0; i < HIST_BUCKETS; i++)
+        dst->counts[i] += src->counts[i];
+    dst->total += src->total;
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+}
+
+int hist_percentile(const hist_t *h, double q) {
+    if (h->total == 0)
+        return 0;
+    if (q < 0.0) q = 0.0;
+    if (q > 100.0) q = 100.0;
+
+    long long rank = (long long)ceil(q / 100.0 * h->total);
+    if (rank < 1)
+        rank = 1;
+
+    long long seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            long long v = bucket_upper(i);
+            if (v > h->max) v = h->max;
+            if (v < h->min) v = h->min;
+            return (int)v;
+        }
+    }
+    return h->max;
+}
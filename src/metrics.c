@@ -1,49 +1,190 @@
 #include <stdio.h>
-#include <math.h>
+#include <stdlib.h>
 #include "metrics.h"
+#include "simd.h"
+
+// Sumas que comparten las variantes process_t[] y tabla SoA
+typedef struct {
+    double turnaround;
+    double waiting;
+    double response;
+    double busy;            // Tiempo que la CPU estuvo ocupada
+    double turnaround2;     // Para fairness
+} metric_sums_t;
+
+static void finish_metrics(const metric_sums_t *s, int n, int total_time,
+                           int num_cpus, latency_hist_t *lh, metrics_t *metrics) {
+    metrics->avg_turnaround_time = s->turnaround / n;
+    metrics->avg_waiting_time = s->waiting / n;
+    metrics->avg_response_time = s->response / n;
+
+    metrics->num_cpus = num_cpus;
+    metrics->migrations = 0;
+    metrics->cpu_utilization = (total_time > 0)
+        ? (s->busy / ((double)total_time * num_cpus)) * 100.0
+        : 0.0;
+    metrics->effective_utilization = metrics->cpu_utilization;
+    metrics->context_switches = 0;
+    metrics->switch_overhead = 0;
+
+    metrics->throughput = (total_time > 0)
+        ? (double)n / total_time
+        : 0.0;
+
+    metrics->fairness_index = (s->turnaround2 > 0)
+        ? s->turnaround * s->turnaround / (n * s->turnaround2)
+        : 0.0;
+
+    if (!lh) {
+        latency_summary_t none = {0, 0, 0, 0, 0};
+        metrics->turnaround = metrics->waiting = metrics->response = none;
+        return;
+    }
+    latency_summarize(&lh->turnaround, &metrics->turnaround);
+    latency_summarize(&lh->waiting, &metrics->waiting);
+    latency_summarize(&lh->response, &metrics->response);
+}
 
 void calculate_metrics(process_t *processes, int n, int total_time,
                        metrics_t *metrics) {
-    double sum_turnaround = 0.0;
-    double sum_waiting = 0.0;
-    double sum_response = 0.0;
-    double busy_time = 0.0;  // Tiempo que la CPU estuvo ocupada
-
-    double sum_x = 0.0;      // Para fairness
-    double sum_x2 = 0.0;
+    metric_sums_t s = {0};
 
     for (int i = 0; i < n; i++) {
         process_t *p = &processes[i];
 
         // Por si no fueron calculadas aún
         p->turnaround_time = p->completion_time - p->arrival_time;
-        p->waiting_time = p->turnaround_time - p->burst_time;
+        p->waiting_time = p->turnaround_time - p->burst_time - p->io_time;
         p->response_time = p->start_time - p->arrival_time;
 
-        sum_turnaround += p->turnaround_time;
-        sum_waiting += p->waiting_time;
-        sum_response += p->response_time;
+        s.turnaround += p->turnaround_time;
+        s.waiting += p->waiting_time;
+        s.response += p->response_time;
+        s.busy += p->burst_time;
+        s.turnaround2 += (double)p->turnaround_time * p->turnaround_time;
+    }
+
+    // Percentiles: histogramas de tamaño fijo, independientes de n
+    latency_hist_t *lh = malloc(sizeof(latency_hist_t));
+    if (lh) {
+        latency_hist_init(lh);
+        latency_hist_record(lh, processes, n);
+    }
+    finish_metrics(&s, n, total_time, 1, lh, metrics);
+    free(lh);
+}
 
-        busy_time += p->burst_time;
+// -----------------------------
+// Variante SoA: una pasada vectorial (simd_latency_block)
+// -----------------------------
+// Los procesos se recorren en bloques de METRICS_BLOCK; el núcleo deja en
+// buckets las cubetas de los tres histogramas, que luego sólo hay que
+// contar.  Con lh == NULL se omiten los histogramas.
+//
+// Con E/S el tiempo de espera es turnaround - CPU - E/S: el núcleo recibe
+// una vista del bloque cuya ráfaga es CPU + E/S, y la E/S se descuenta
+// después del tiempo ocupado.
+#define METRICS_BLOCK 1024
 
-        sum_x += p->turnaround_time;
-        sum_x2 += pow(p->turnaround_time, 2);
+static void latency_scan(const proc_table_t *pt, latency_hist_t *lh,
+                         simd_sums_t *sums) {
+    int buckets[3 * METRICS_BLOCK];
+    int service[METRICS_BLOCK];
+    long long io = 0;
+    simd_sums_init(sums);
+    for (int from = 0; from < pt->n; from += METRICS_BLOCK) {
+        int len = pt->n - from < METRICS_BLOCK ? pt->n - from : METRICS_BLOCK;
+        if (pt->io) {
+            proc_table_t view = *pt;
+            view.arrival = pt->arrival + from;
+            view.start = pt->start + from;
+            view.completion = pt->completion + from;
+            view.burst = service;
+            for (int i = 0; i < len; i++) {
+                service[i] = pt->burst[from + i] + pt->io[from + i];
+                io += pt->io[from + i];
+            }
+            simd_latency_block(&view, 0, len, sums, buckets);
+        } else {
+            simd_latency_block(pt, from, len, sums, buckets);
+        }
+        if (lh) {
+            hist_record_buckets(&lh->turnaround, buckets, len);
+            hist_record_buckets(&lh->waiting, buckets + len, len);
+            hist_record_buckets(&lh->response, buckets + 2 * len, len);
+        }
     }
+    sums->busy -= io;
+    if (lh && pt->n > 0) {
+        hist_add_range(&lh->turnaround, sums->min[0], sums->max[0]);
+        hist_add_range(&lh->waiting, sums->min[1], sums->max[1]);
+        hist_add_range(&lh->response, sums->min[2], sums->max[2]);
+    }
+}
 
-    metrics->avg_turnaround_time = sum_turnaround / n;
-    metrics->avg_waiting_time = sum_waiting / n;
-    metrics->avg_response_time = sum_response / n;
+void calculate_metrics_table(const proc_table_t *pt, int total_time,
+                             metrics_t *metrics) {
+    calculate_metrics_table_cpus(pt, total_time, 1, metrics);
+}
 
-    metrics->cpu_utilization = (total_time > 0)
-        ? (busy_time / total_time) * 100.0
-        : 0.0;
+void calculate_metrics_table_cpus(const proc_table_t *pt, int total_time,
+                                  int num_cpus, metrics_t *metrics) {
+    latency_hist_t *lh = malloc(sizeof(latency_hist_t));
+    if (lh)
+        latency_hist_init(lh);
 
-    metrics->throughput = (total_time > 0)
-        ? (double)n / total_time
-        : 0.0;
+    simd_sums_t v;
+    latency_scan(pt, lh, &v);
 
-    metrics->fairness_index = (sum_x2 > 0)
-        ? pow(sum_x, 2) / (n * sum_x2)
-        : 0.0;
+    metric_sums_t s = {
+        (double)v.turnaround, (double)v.waiting, (double)v.response, (double)v.busy,
+        (v.turnaround2[0] + v.turnaround2[1]) + (v.turnaround2[2] + v.turnaround2[3]),
+    };
+    finish_metrics(&s, pt->n, total_time, num_cpus, lh, metrics);
+    free(lh);
+}
+
+void metrics_add_switches(metrics_t *metrics, const switch_stats_t *stats,
+                          int total_time) {
+    metrics->context_switches = stats->switches;
+    metrics->switch_overhead = stats->overhead;
+    if (total_time > 0)
+        metrics->cpu_utilization = metrics->effective_utilization +
+            stats->overhead / ((double)total_time * metrics->num_cpus) * 100.0;
+}
+
+void latency_hist_init(latency_hist_t *lh) {
+    hist_init(&lh->turnaround);
+    hist_init(&lh->waiting);
+    hist_init(&lh->response);
+}
+
+void latency_hist_record(latency_hist_t *lh, const process_t *processes, int n) {
+    for (int i = 0; i < n; i++) {
+        const process_t *p = &processes[i];
+        int turnaround = p->completion_time - p->arrival_time;
+        hist_record(&lh->turnaround, turnaround);
+        hist_record(&lh->waiting, turnaround - p->burst_time - p->io_time);
+        hist_record(&lh->response, p->start_time - p->arrival_time);
+    }
+}
+
+void latency_hist_record_table(latency_hist_t *lh, const proc_table_t *pt) {
+    simd_sums_t sums;
+    latency_scan(pt, lh, &sums);
+}
+
+void latency_hist_merge(latency_hist_t *dst, const latency_hist_t *src) {
+    hist_merge(&dst->turnaround, &src->turnaround);
+    hist_merge(&dst->waiting, &src->waiting);
+    hist_merge(&dst->response, &src->response);
+}
+
+void latency_summarize(const hist_t *h, latency_summary_t *out) {
+    out->p50 = hist_percentile(h, 50.0);
+    out->p95 = hist_percentile(h, 95.0);
+    out->p99 = hist_percentile(h, 99.0);
+    out->p999 = hist_percentile(h, 99.9);
+    out->max = hist_max(h);
 }
 
@@ -0,0 +1,48 @@
+#include <stdlib.h>
+#include "mlfq.h"
+
+int mlfq_levels_init(mlfq_levels_t *lv, int num_queues, int n, mlfq_job_t *job) {
+    lv->num_queues = num_queues;
+    lv->words = (num_queues + 63) / 64;
+    lv->count = 0;
+    lv->epoch = 0;
+    lv->shared_job = job != NULL;
+    lv->head = malloc(num_queues * sizeof(int));
+    lv->tail = malloc(num_queues * sizeof(int));
+    lv->bitmap = calloc(lv->words, sizeof(unsigned long long));
+    lv->job = job ? job : malloc((n > 0 ? n : 1) * sizeof(mlfq_job_t));
+    if (!lv->head || !lv->tail || !lv->bitmap || !lv->job)
+        return -1;
+    for (int l = 0; l < num_queues; l++)
+        lv->head[l] = lv->tail[l] = -1;
+    return 0;
+}
+
+void mlfq_levels_free(mlfq_levels_t *lv) {
+    free(lv->head);
+    free(lv->tail);
+    free(lv->bitmap);
+    if (!lv->shared_job)
+        free(lv->job);
+    lv->head = lv->tail = NULL;
+    lv->bitmap = NULL;
+    lv->job = NULL;
+}
+
+void mlfq_boost(mlfq_levels_t *lv) {
+    for (int l = 1; l < lv->num_queues; l++) {
+        if (lv->head[l] < 0)
+            continue;
+        if (lv->tail[0] < 0)
+            lv->head[0] = lv->head[l];
+        else
+            lv->job[lv->tail[0]].next = lv->head[l];
+        lv->tail[0] = lv->tail[l];
+        lv->head[l] = lv->tail[l] = -1;
+    }
+    for (int w = 0; w < lv->words; w++)
+        lv->bitmap[w] = 0;
+    if (lv->head[0] >= 0)
+        lv->bitmap[0] = 1;
+    lv->epoch++;
+}
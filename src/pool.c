@@ -0,0 +1,241 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
+#include "pool.h"
+
+// -----------------------------
+// Reparto con robo de trabajo
+// -----------------------------
+// Cada worker empieza con un tramo contiguo [lo, hi) de tareas, empaquetado
+// en una palabra de 64 bits para que dueño y ladrones lo modifiquen con un
+// único CAS.  El dueño consume por delante; cuando se queda sin tareas roba
+// la mitad superior del tramo de otro worker.  Un tramo sólo contiene
+// tareas aún no empezadas, así que su valor describe por completo el estado
+// y el CAS no sufre ABA.
+typedef struct {
+    uint64_t range;         // lo | hi << 32
+    char pad[64 - sizeof(uint64_t)];
+} pool_range_t;
+
+typedef struct {
+    pool_task_fn fn;
+    void *ctx;
+    int num_threads;
+    pool_range_t *ranges;
+} pool_job_t;
+
+typedef struct {
+    pool_job_t *job;
+    int worker;
+} pool_worker_t;
+
+static inline uint64_t range_pack(uint32_t lo, uint32_t hi) {
+    return lo | (uint64_t)hi << 32;
+}
+
+static int range_take(pool_range_t *r) {
+    uint64_t cur = __atomic_load_n(&r->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t lo = (uint32_t)cur, hi = (uint32_t)(cur >> 32);
+        if (lo >= hi)
+            return -1;
+        if (__atomic_compare_exchange_n(&r->range, &cur, range_pack(lo + 1, hi),
+                                        0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return (int)lo;
+    }
+}
+
+// Roba la mitad superior (al menos una tarea) del tramo de victim y la
+// deja como tramo propio; devuelve 0 si no había nada que robar
+static int range_steal(pool_range_t *victim, pool_range_t *own) {
+    uint64_t cur = __atomic_load_n(&victim->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t lo = (uint32_t)cur, hi = (uint32_t)(cur >> 32);
+        if (lo >= hi)
+            return 0;
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (__atomic_compare_exchange_n(&victim->range, &cur, range_pack(lo, mid),
+                                        0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&own->range, range_pack(mid, hi), __ATOMIC_RELEASE);
+            return 1;
+        }
+    }
+}
+
+static void *pool_thread(void *arg) {
+    pool_worker_t *w = arg;
+    pool_job_t *job = w->job;
+    pool_range_t *own = &job->ranges[w->worker];
+    for (;;) {
+        int task;
+        while ((task = range_take(own)) >= 0)
+            job->fn(job->ctx, task, w->worker);
+
+        // Sin trabajo propio: una vuelta por los demás; si todos están
+        // vacíos no quedan tareas sin repartir
+        int stolen = 0;
+        for (int k = 1; k < job->num_threads && !stolen; k++)
+            stolen = range_steal(&job->ranges[(w->worker + k) % job->num_threads], own);
+        if (!stolen)
+            break;
+    }
+    return NULL;
+}
+
+int pool_default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+int pool_run(int num_tasks, int num_threads, pool_task_fn fn, void *ctx) {
+    if (num_tasks <= 0)
+        return 0;
+    if (num_threads <= 0)
+        num_threads = pool_default_threads();
+    if (num_threads > num_tasks)
+        num_threads = num_tasks;
+
+    pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+    pool_worker_t *workers = malloc(num_threads * sizeof(pool_worker_t));
+    pool_range_t *ranges = aligned_alloc(64, num_threads * sizeof(pool_range_t));
+    if (!threads || !workers || !ranges) {
+        free(threads);
+        free(workers);
+        free(ranges);
+        return -1;
+    }
+
+    // Tramos iniciales del mismo tamaño (±1)
+    for (int i = 0; i < num_threads; i++) {
+        uint32_t lo = (uint32_t)((long long)num_tasks * i / num_threads);
+        uint32_t hi = (uint32_t)((long long)num_tasks * (i + 1) / num_threads);
+        ranges[i].range = range_pack(lo, hi);
+    }
+    pool_job_t job = { fn, ctx, num_threads, ranges };
+
+    // El hilo llamante hace de worker 0.  Si un hilo no arranca, su tramo
+    // lo roban los demás.
+    int started = 1;
+    for (int i = 1; i < num_threads; i++) {
+        workers[i].job = &job;
+        workers[i].worker = i;
+        if (pthread_create(&threads[i], NULL, pool_thread, &workers[i]) != 0)
+            break;
+        started++;
+    }
+    workers[0].job = &job;
+    workers[0].worker = 0;
+    pool_thread(&workers[0]);
+
+    for (int i = 1; i < started; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+    free(workers);
+    free(ranges);
+    return 0;
+}
+
+// -----------------------------
+// Hilos que avanzan a la vez
+// -----------------------------
+void pool_barrier_init(pool_barrier_t *b, int threads) {
+    b->count = 0;
+    b->sense = 0;
+    b->threads = threads;
+}
+
+void pool_barrier_wait(pool_barrier_t *b, int *sense) {
+    *sense = !*sense;
+    if (__atomic_add_fetch(&b->count, 1, __ATOMIC_ACQ_REL) == b->threads) {
+        __atomic_store_n(&b->count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&b->sense, *sense, __ATOMIC_RELEASE);
+        return;
+    }
+    for (int spins = 0; __atomic_load_n(&b->sense, __ATOMIC_ACQUIRE) != *sense; spins++)
+        if (spins > 1000)
+            sched_yield();
+}
+
+typedef struct {
+    pool_worker_fn fn;
+    void *ctx;
+    int num_workers;
+    int go;                 // 1 = arrancar, -1 = faltan hilos
+} pool_spawn_t;
+
+typedef struct {
+    pool_spawn_t *job;
+    int worker;
+} pool_member_t;
+
+static void *pool_member(void *arg) {
+    pool_member_t *m = arg;
+    int go;
+    while ((go = __atomic_load_n(&m->job->go, __ATOMIC_ACQUIRE)) == 0)
+        sched_yield();
+    if (go > 0)
+        m->job->fn(m->job->ctx, m->worker, m->job->num_workers);
+    return NULL;
+}
+
+int pool_spawn(int num_threads, pool_worker_fn fn, void *ctx) {
+    if (num_threads < 1)
+        num_threads = 1;
+    pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+    pool_member_t *members = malloc(num_threads * sizeof(pool_member_t));
+    pool_spawn_t job = { fn, ctx, num_threads, 0 };
+
+    // Nadie empieza hasta que están todos: fn no admite que falte uno
+    int started = 1;
+    for (int i = 1; i < num_threads && threads && members; i++) {
+        members[i].job = &job;
+        members[i].worker = i;
+        if (pthread_create(&threads[i], NULL, pool_member, &members[i]) != 0)
+            break;
+        started++;
+    }
+    int ok = started == num_threads;
+    __atomic_store_n(&job.go, ok ? 1 : -1, __ATOMIC_RELEASE);
+    fn(ctx, 0, ok ? num_threads : 1);
+
+    for (int i = 1; i < started; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+    free(members);
+    return ok ? num_threads : 1;
+}
+
+// -----------------------------
+// Hilo en segundo plano
+// -----------------------------
+struct pool_thread {
+    pthread_t thread;
+    void (*fn)(void *ctx);
+    void *ctx;
+};
+
+static void *pool_background(void *arg) {
+    pool_thread_t *t = arg;
+    t->fn(t->ctx);
+    return NULL;
+}
+
+pool_thread_t *pool_thread_start(void (*fn)(void *ctx), void *ctx) {
+    pool_thread_t *t = malloc(sizeof(pool_thread_t));
+    if (!t)
+        return NULL;
+    t->fn = fn;
+    t->ctx = ctx;
+    if (pthread_create(&t->thread, NULL, pool_background, t) != 0) {
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+void pool_thread_join(pool_thread_t *t) {
+    pthread_join(t->thread, NULL);
+    free(t);
+}
@@ -0,0 +1,269 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "proctable.h"
+
+#define PROC_TABLE_FIELDS 7
+
+int proc_table_init(proc_table_t *t, int n) {
+    size_t count = n > 0 ? (size_t)n : 1;
+    t->n = n;
+    t->block = malloc(PROC_TABLE_FIELDS * count * sizeof(int));
+    if (!t->block)
+        return -1;
+    t->arrival    = t->block;
+    t->burst      = t->block + count;
+    t->remaining  = t->block + 2 * count;
+    t->pid        = t->block + 3 * count;
+    t->priority   = t->block + 4 * count;
+    t->start      = t->block + 5 * count;
+    t->completion = t->block + 6 * count;
+    t->first = t->bursts = t->io = t->io_block = NULL;
+    return 0;
+}
+
+int proc_table_init_io(proc_table_t *t, size_t num_bursts) {
+    size_t count = t->n > 0 ? (size_t)t->n : 1;
+    if (num_bursts > INT_MAX)
+        return -1;
+    t->io_block = malloc((2 * count + 1 + num_bursts) * sizeof(int));
+    if (!t->io_block)
+        return -1;
+    t->first  = t->io_block;
+    t->io     = t->io_block + count + 1;
+    t->bursts = t->io_block + 2 * count + 1;
+    return 0;
+}
+
+int proc_table_init_shared(proc_table_t *t, const proc_table_t *src) {
+    size_t count = src->n > 0 ? (size_t)src->n : 1;
+    t->n = src->n;
+    t->block = malloc(3 * count * sizeof(int));
+    if (!t->block)
+        return -1;
+    t->arrival    = src->arrival;
+    t->burst      = src->burst;
+    t->pid        = src->pid;
+    t->priority   = src->priority;
+    t->remaining  = t->block;
+    t->start      = t->block + count;
+    t->completion = t->block + 2 * count;
+    t->first      = src->first;
+    t->bursts     = src->bursts;
+    t->io         = src->io;
+    t->io_block   = NULL;
+    return 0;
+}
+
+void proc_table_free(proc_table_t *t) {
+    free(t->block);
+    free(t->io_block);
+    t->block = NULL;
+    t->io_block = NULL;
+    t->first = t->bursts = t->io = NULL;
+    t->n = 0;
+}
+
+int proc_table_from_processes(proc_table_t *t, const process_t *processes, int n) {
+    if (proc_table_init(t, n) != 0)
+        return -1;
+    for (int i = 0; i < n; i++) {
+        t->arrival[i] = processes[i].arrival_time;
+        t->burst[i] = processes[i].burst_time;
+        t->pid[i] = processes[i].pid;
+        t->priority[i] = processes[i].priority;
+        t->remaining[i] = t->burst[i];
+        t->start[i] = t->completion[i] = 0;
+    }
+
+    size_t num_bursts = 0;
+    for (int i = 0; i < n; i++)
+        if (processes[i].num_bursts > 1)
+            num_bursts += processes[i].num_bursts;
+    if (num_bursts == 0)
+        return 0;
+    if (proc_table_init_io(t, num_bursts) != 0) {
+        proc_table_free(t);
+        return -1;
+    }
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        const process_t *p = &processes[i];
+        t->first[i] = k;
+        t->io[i] = p->io_time;
+        if (p->num_bursts > 1)
+            for (int b = 0; b < p->num_bursts; b++)
+                t->bursts[k++] = p->bursts[b];
+    }
+    t->first[n] = k;
+    return 0;
+}
+
+int proc_table_from_records(proc_table_t *t, const workload_record_t *records,
+                            size_t count) {
+    if (count > INT_MAX || proc_table_init(t, (int)count) != 0)
+        return -1;
+    for (int i = 0; i < t->n; i++) {
+        t->arrival[i] = records[i].arrival_time;
+        t->burst[i] = records[i].burst_time;
+        t->pid[i] = records[i].pid;
+        t->priority[i] = records[i].priority;
+        t->remaining[i] = t->burst[i];
+        t->start[i] = t->completion[i] = 0;
+    }
+    return 0;
+}
+
+int proc_table_from_view(proc_table_t *t, const workload_view_t *view) {
+    if (proc_table_from_records(t, view->records, view->count) != 0)
+        return -1;
+    if (!view->burst_counts || view->num_bursts == 0)
+        return 0;
+    if (proc_table_init_io(t, view->num_bursts) != 0) {
+        proc_table_free(t);
+        return -1;
+    }
+    // La vista ya está validada (workload_map_binary)
+    memcpy(t->bursts, view->bursts, view->num_bursts * sizeof(int));
+    int k = 0;
+    for (int i = 0; i < t->n; i++) {
+        int c = (int)view->burst_counts[i];
+        t->first[i] = k;
+        t->io[i] = 0;
+        for (int b = 1; b < c; b += 2)
+            t->io[i] += t->bursts[k + b];
+        k += c;
+    }
+    t->first[t->n] = k;
+    return 0;
+}
+
+int proc_table_load(const char *filename, proc_table_t *t, char *err, size_t errlen) {
+    workload_view_t view;
+    FILE *f = fopen(filename, "rb");
+    char magic[sizeof(WORKLOAD_MAGIC)] = {0};
+    size_t got = f ? fread(magic, 1, sizeof(magic), f) : 0;
+    if (f)
+        fclose(f);
+
+    // Binario: directamente desde el archivo mapeado
+    if (got == sizeof(magic) && memcmp(magic, WORKLOAD_MAGIC, sizeof(magic)) == 0 &&
+        workload_map_binary(filename, &view, NULL, 0) == 0) {
+        int rc = proc_table_from_view(t, &view);
+        workload_unmap(&view);
+        if (rc != 0 && err)
+            snprintf(err, errlen, "%s: out of memory for %zu processes",
+                     filename, view.count);
+        return rc;
+    }
+
+    // Texto (o binario en un host big-endian): vía workload_t
+    workload_t wl;
+    workload_init(&wl);
+    if (workload_load(filename, &wl, err, errlen) != 0) {
+        workload_free(&wl);
+        return -1;
+    }
+    int rc = proc_table_from_processes(t, wl.processes, wl.n);
+    workload_free(&wl);
+    if (rc != 0 && err)
+        snprintf(err, errlen, "%s: out of memory", filename);
+    return rc;
+}
+
+void proc_table_to_processes(const proc_table_t *t, process_t *processes) {
+    for (int i = 0; i < t->n; i++) {
+        process_t *p = &processes[i];
+        p->pid = t->pid[i];
+        p->arrival_time = t->arrival[i];
+        p->burst_time = t->burst[i];
+        p->priority = t->priority[i];
+        p->remaining_time = t->remaining[i];
+        p->start_time = t->start[i];
+        p->completion_time = t->completion[i];
+        p->io_time = t->io ? t->io[i] : 0;
+        p->turnaround_time = p->completion_time - p->arrival_time;
+        p->waiting_time = p->turnaround_time - p->burst_time - p->io_time;
+        p->response_time = p->start_time - p->arrival_time;
+    }
+}
+
+// Copia t sin los procesos [pos, pos + del) y con p (si no es NULL) en pos
+static int proc_table_splice(proc_table_t *t, int pos, int del, const process_t *p) {
+    int add = p ? 1 : 0;
+    int n = t->n - del + add;
+    proc_table_t s;
+    if (proc_table_init(&s, n) != 0)
+        return -1;
+
+    int *from[PROC_TABLE_FIELDS] = { t->arrival, t->burst, t->remaining, t->pid,
+                                     t->priority, t->start, t->completion };
+    int *to[PROC_TABLE_FIELDS] = { s.arrival, s.burst, s.remaining, s.pid,
+                                   s.priority, s.start, s.completion };
+    for (int f = 0; f < PROC_TABLE_FIELDS; f++) {
+        memcpy(to[f], from[f], pos * sizeof(int));
+        memcpy(to[f] + pos + add, from[f] + pos + del,
+               (t->n - pos - del) * sizeof(int));
+    }
+    if (p) {
+        s.arrival[pos] = p->arrival_time;
+        s.burst[pos] = s.remaining[pos] = p->burst_time;
+        s.pid[pos] = p->pid;
+        s.priority[pos] = p->priority;
+        s.start[pos] = s.completion[pos] = 0;
+    }
+
+    // Ráfagas: las de los procesos conservados se desplazan en bloque
+    int added = p && p->num_bursts > 1 ? p->num_bursts : 0;
+    int cut = t->first ? t->first[pos] : 0;
+    int removed = t->first ? t->first[pos + del] - cut : 0;
+    size_t total = (t->first ? (size_t)t->first[t->n] : 0) - removed + added;
+    if (total > 0) {
+        if (proc_table_init_io(&s, total) != 0) {
+            proc_table_free(&s);
+            return -1;
+        }
+        int tail = t->first ? t->first[t->n] - cut - removed : 0;
+        for (int i = 0; i < pos; i++) {
+            s.first[i] = t->first ? t->first[i] : 0;
+            s.io[i] = t->io ? t->io[i] : 0;
+        }
+        for (int i = pos + del; i <= t->n; i++) {
+            s.first[i - del + add] = (t->first ? t->first[i] - removed : 0) + added;
+            if (i < t->n)
+                s.io[i - del + add] = t->io ? t->io[i] : 0;
+        }
+        if (t->first)
+            memcpy(s.bursts, t->bursts, cut * sizeof(int));
+        if (p) {
+            s.first[pos] = cut;
+            s.io[pos] = added ? p->io_time : 0;
+            if (added)
+                memcpy(s.bursts + cut, p->bursts, added * sizeof(int));
+        }
+        if (tail > 0)
+            memcpy(s.bursts + cut + added, t->bursts + cut + removed,
+                   tail * sizeof(int));
+    }
+
+    proc_table_free(t);
+    *t = s;
+    return 0;
+}
+
+int proc_table_insert(proc_table_t *t, int pos, const process_t *p) {
+    return proc_table_splice(t, pos, 0, p);
+}
+
+int proc_table_remove(proc_table_t *t, int pos) {
+    return proc_table_splice(t, pos, 1, NULL);
+}
+
+int proc_table_makespan(const proc_table_t *t) {
+    int makespan = 0;
+    for (int i = 0; i < t->n; i++)
+        if (t->completion[i] > makespan)
+            makespan = t->completion[i];
+    return makespan;
+}
@@ -0,0 +1,54 @@
+#include <stdlib.h>
+#include "queue.h"
+
+int queue_init(queue_t *q, int capacity) {
+    if (capacity < 1)
+        capacity = 1;
+    q->head = 0;
+    q->count = 0;
+    q->capacity = capacity;
+    q->buf = malloc(capacity * sizeof(int));
+    return q->buf ? 0 : -1;
+}
+
+void queue_free(queue_t *q) {
+    free(q->buf);
+    q->buf = NULL;
+    q->count = 0;
+}
+
+static int queue_grow(queue_t *q) {
+    int capacity = q->capacity * 2;
+    int *buf = malloc(capacity * sizeof(int));
+    if (!buf)
+        return -1;
+    // Desenrolla el contenido para que vuelva a empezar en 0
+    for (int i = 0; i < q->count; i++)
+        buf[i] = q->buf[(q->head + i) % q->capacity];
+    free(q->buf);
+    q->buf = buf;
+    q->head = 0;
+    q->capacity = capacity;
+    return 0;
+}
+
+int queue_push(queue_t *q, int idx) {
+    if (q->count == q->capacity && queue_grow(q) != 0)
+        return -1;
+    int tail = q->head + q->count;
+    if (tail >= q->capacity)
+        tail -= q->capacity;
+    q->buf[tail] = idx;
+    q->count++;
+    return 0;
+}
+
+int queue_pop(queue_t *q) {
+    if (q->count == 0)
+        return -1;
+    int idx = q->buf[q->head];
+    if (++q->head == q->capacity)
+        q->head = 0;
+    q->count--;
+    return idx;
+}
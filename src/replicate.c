@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include "replicate.h"
+#include "proctable.h"
+#include "pool.h"
+
+// -----------------------------
+// Ejecución
+// -----------------------------
+typedef struct {
+    int failed;
+    char err[256];          // Motivo del primer fallo
+} rep_worker_t;
+
+typedef struct {
+    const gen_spec_t *spec;
+    const uint64_t *seeds;
+    const int *selected;
+    int quantum;
+    mlfq_config_t *config;
+    const switch_cost_t *cost;
+    metrics_t *runs;
+    rep_worker_t *workers;
+} rep_job_t;
+
+void replicate_seeds(uint64_t seed, int k, uint64_t *seeds) {
+    rng_t rng;
+    rng_seed(&rng, seed);
+    for (int r = 0; r < k; r++)
+        seeds[r] = rng_next(&rng);
+}
+
+static void rep_task(void *ctx, int r, int worker) {
+    rep_job_t *job = ctx;
+    rep_worker_t *w = &job->workers[worker];
+    if (w->failed)
+        return;
+
+    gen_spec_t spec = *job->spec;
+    spec.seed = job->seeds[r];
+    proc_table_t pt;
+    if (generate_table(&spec, &pt, w->err, sizeof(w->err)) != 0) {
+        w->failed = 1;
+        return;
+    }
+
+    // Los motores no modifican la entrada: todos los algoritmos
+    // planifican la misma tabla
+    for (int alg = 0; alg < SCHED_COUNT; alg++) {
+        if (!job->selected[alg])
+            continue;
+        metrics_t *m = &job->runs[r * SCHED_COUNT + alg];
+        switch_stats_t switches;
+        if (schedule_run_table_cost(alg, &pt, job->quantum, job->config, job->cost,
+                                    NULL, &switches) != 0) {
+            snprintf(w->err, sizeof(w->err), "out of memory simulating %s",
+                     sched_alg_name(alg));
+            w->failed = 1;
+            break;
+        }
+        int makespan = proc_table_makespan(&pt);
+        calculate_metrics_table(&pt, makespan, m);
+        metrics_add_switches(m, &switches, makespan);
+    }
+    proc_table_free(&pt);
+}
+
+int replicate_run(const gen_spec_t *spec, int k, const int selected[SCHED_COUNT],
+                  int quantum, mlfq_config_t *config, const switch_cost_t *cost,
+                  int num_threads, metrics_t *runs, char *err, size_t errlen) {
+    if (k <= 0)
+        return 0;
+    if (num_threads <= 0)
+        num_threads = pool_default_threads();
+    if (num_threads > k)
+        num_threads = k;
+
+    uint64_t *seeds = malloc(k * sizeof(uint64_t));
+    rep_worker_t *workers = calloc(num_threads, sizeof(rep_worker_t));
+    if (!seeds || !workers) {
+        free(seeds);
+        free(workers);
+        snprintf(err, errlen, "out of memory generating replications");
+        return -1;
+    }
+    replicate_seeds(spec->seed, k, seeds);
+
+    memset(runs, 0, (size_t)k * SCHED_COUNT * sizeof(metrics_t));
+    rep_job_t job = { spec, seeds, selected, quantum, config, cost, runs, workers };
+    int rc = pool_run(k, num_threads, rep_task, &job);
+    if (rc != 0)
+        snprintf(err, errlen, "out of memory starting threads");
+
+    for (int i = 0; i < num_threads && rc == 0; i++)
+        if (workers[i].failed) {
+            snprintf(err, errlen, "%s", workers[i].err);
+            rc = -1;
+        }
+    free(workers);
+    free(seeds);
+    return rc;
+}
+
+// -----------------------------
+// Agregación
+// -----------------------------
+static const struct {
+    const char *name;
+    size_t offset;
+    char type;              // 'd' double, 'i' int, 'l' long long
+} rep_metrics[REP_METRICS] = {
+#define REP_DOUBLE(name, field) { name, offsetof(metrics_t, field), 'd' }
+#define REP_COUNT(name, field) { name, offsetof(metrics_t, field), 'l' }
+#define REP_LATENCY(name, field)                                              \
+    { name "_p50", offsetof(metrics_t, field.p50), 'i' },                     \
+    { name "_p95", offsetof(metrics_t, field.p95), 'i' },                     \
+    { name "_p99", offsetof(metrics_t, field.p99), 'i' },                     \
+    { name "_p999", offsetof(metrics_t, field.p999), 'i' },                   \
+    { name "_max", offsetof(metrics_t, field.max), 'i' }
+    REP_DOUBLE("avg_turnaround", avg_turnaround_time),
+    REP_DOUBLE("avg_waiting", avg_waiting_time),
+    REP_DOUBLE("avg_response", avg_response_time),
+    REP_DOUBLE("cpu_utilization", cpu_utilization),
+    REP_DOUBLE("throughput", throughput),
+    REP_DOUBLE("fairness", fairness_index),
+    REP_COUNT("context_switches", context_switches),
+    REP_COUNT("switch_overhead", switch_overhead),
+    REP_DOUBLE("effective_utilization", effective_utilization),
+    REP_LATENCY("turnaround", turnaround),
+    REP_LATENCY("waiting", waiting),
+    REP_LATENCY("response", response),
+#undef REP_DOUBLE
+#undef REP_COUNT
+#undef REP_LATENCY
+};
+
+const char *rep_metric_name(int i) {
+    return rep_metrics[i].name;
+}
+
+double rep_metric_value(const metrics_t *m, int i) {
+    const char *p = (const char *)m + rep_metrics[i].offset;
+    switch (rep_metrics[i].type) {
+        case 'i': return *(const int *)p;
+        case 'l': return (double)*(const long long *)p;
+        default:  return *(const double *)p;
+    }
+}
+
+// Cuantil 0.975 de la t de Student con df grados de libertad: tabla hasta
+// 30 y expansión de Cornish-Fisher a partir de ahí
+static double t_975(int df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df <= 30)
+        return table[df - 1];
+    const double z = 1.959964;
+    double z3 = z * z * z, z5 = z3 * z * z;
+    return z + (z3 + z) / (4.0 * df) + (5 * z5 + 16 * z3 + 3 * z) / (96.0 * df * df);
+}
+
+void rep_summarize(const metrics_t *runs, int k, int stride,
+                   rep_stat_t out[REP_METRICS]) {
+    for (int i = 0; i < REP_METRICS; i++) {
+        // Welford: estable aunque las medias sean grandes
+        double mean = 0.0, m2 = 0.0;
+        for (int r = 0; r < k; r++) {
+            double x = rep_metric_value(&runs[(size_t)r * stride], i);
+            double d = x - mean;
+            mean += d / (r + 1);
+            m2 += d * (x - mean);
+        }
+        out[i].mean = mean;
+        out[i].stddev = k > 1 ? sqrt(m2 / (k - 1)) : 0.0;
+        double half = k > 1 ? t_975(k - 1) * out[i].stddev / sqrt(k) : 0.0;
+        out[i].ci_lo = mean - half;
+        out[i].ci_hi = mean + half;
+    }
+}
@@ -0,0 +1,288 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "resim.h"
+
+// Con tantas instantáneas se descarta una de cada dos y se duplica el
+// intervalo: la memoria queda acotada sea cual sea la duración
+#define RESIM_MAX_SNAPS 256
+
+int resim_init(resim_t *rs, int interval) {
+    rs->stats.switches = 0;
+    rs->stats.overhead = 0;
+    rs->alg = SCHED_FIFO;
+    rs->quantum = 1;
+    rs->config = NULL;
+    rs->interval = interval > 0 ? interval : 1;
+    rs->every = rs->interval;
+    rs->snaps = NULL;
+    rs->num_snaps = 0;
+    rs->dirty = 0;
+    rs->resumed_at = 0;
+    rs->steps = 0;
+    rs->running = 0;
+    rs->failed = 0;
+    rs->step = 0;
+    rs->tap = NULL;
+    if (proc_table_init(&rs->pt, 0) != 0)
+        return -1;
+    if (timeline_init(&rs->timeline, 256) != 0) {
+        proc_table_free(&rs->pt);
+        return -1;
+    }
+    rs->snaps = malloc(RESIM_MAX_SNAPS * sizeof(sched_snapshot_t));
+    if (!rs->snaps) {
+        timeline_free(&rs->timeline);
+        proc_table_free(&rs->pt);
+        return -1;
+    }
+    return 0;
+}
+
+// Conserva las `keep` primeras instantáneas
+static void drop_snaps(resim_t *rs, int keep) {
+    for (int i = keep; i < rs->num_snaps; i++)
+        sched_snapshot_free(&rs->snaps[i]);
+    if (keep < rs->num_snaps)
+        rs->num_snaps = keep;
+}
+
+void resim_free(resim_t *rs) {
+    if (rs->running)
+        resim_end(rs);
+    drop_snaps(rs, 0);
+    free(rs->snaps);
+    rs->snaps = NULL;
+    timeline_free(&rs->timeline);
+    proc_table_free(&rs->pt);
+}
+
+void resim_invalidate(resim_t *rs) {
+    drop_snaps(rs, 0);
+    rs->every = rs->interval;
+    rs->dirty = 0;
+}
+
+// Por (arrival, posición original), guardada en remaining_time de la copia
+static int cmp_arrival(const void *a, const void *b) {
+    const process_t *x = a, *y = b;
+    if (x->arrival_time != y->arrival_time)
+        return x->arrival_time < y->arrival_time ? -1 : 1;
+    return (x->remaining_time > y->remaining_time) - (x->remaining_time < y->remaining_time);
+}
+
+int resim_load(resim_t *rs, const process_t *processes, int n) {
+    process_t *sorted = malloc((n > 0 ? n : 1) * sizeof(process_t));
+    if (!sorted)
+        return -1;
+    for (int i = 0; i < n; i++) {
+        sorted[i] = processes[i];
+        sorted[i].remaining_time = i;
+    }
+    qsort(sorted, n, sizeof(process_t), cmp_arrival);
+
+    proc_table_t pt;
+    int rc = proc_table_from_processes(&pt, sorted, n);
+    free(sorted);
+    if (rc != 0)
+        return -1;
+    proc_table_free(&rs->pt);
+    rs->pt = pt;
+    resim_invalidate(rs);
+    return 0;
+}
+
+void resim_set_policy(resim_t *rs, sched_alg_t alg, int quantum,
+                      mlfq_config_t *config) {
+    if (alg != rs->alg || config != rs->config ||
+        (alg == SCHED_RR && quantum != rs->quantum))
+        resim_invalidate(rs);
+    rs->alg = alg;
+    rs->quantum = quantum;
+    rs->config = config;
+}
+
+static void touch(resim_t *rs, int arrival) {
+    if (arrival < rs->dirty)
+        rs->dirty = arrival;
+}
+
+int resim_add(resim_t *rs, const process_t *p) {
+    // Detrás de todos los que llegan a la vez o antes
+    int lo = 0, hi = rs->pt.n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (rs->pt.arrival[mid] <= p->arrival_time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (proc_table_insert(&rs->pt, lo, p) != 0)
+        return -1;
+    touch(rs, p->arrival_time);
+    return lo;
+}
+
+int resim_remove(resim_t *rs, int pos) {
+    int arrival = rs->pt.arrival[pos];
+    if (proc_table_remove(&rs->pt, pos) != 0)
+        return -1;
+    touch(rs, arrival);
+    return 0;
+}
+
+int resim_find(const resim_t *rs, int pid) {
+    for (int i = 0; i < rs->pt.n; i++)
+        if (rs->pt.pid[i] == pid)
+            return i;
+    return -1;
+}
+
+// Deja una de cada dos instantáneas (las de índice impar, que son las de
+// múltiplos del nuevo intervalo) y duplica el intervalo
+static void thin_snaps(resim_t *rs) {
+    int k = 0;
+    for (int i = 0; i < rs->num_snaps; i++) {
+        if (i % 2 == 1)
+            rs->snaps[k++] = rs->snaps[i];
+        else
+            sched_snapshot_free(&rs->snaps[i]);
+    }
+    rs->num_snaps = k;
+    rs->every *= 2;
+}
+
+// Los eventos van a la línea de tiempo y, si lo hay, al tap
+static void resim_event(void *ctx, const timeline_event_t *ev) {
+    resim_t *rs = ctx;
+    if (timeline_append_event(&rs->timeline, ev) != 0)
+        rs->failed = 1;
+    if (rs->tap)
+        rs->tap->on_event(rs->tap->ctx, ev);
+}
+
+static int resim_flush(void *ctx) {
+    resim_t *rs = ctx;
+    if (rs->tap && rs->tap->flush)
+        return rs->tap->flush(rs->tap->ctx);
+    return 0;
+}
+
+int resim_begin(resim_t *rs, const timeline_sink_t *tap) {
+    rs->steps = 0;
+    rs->running = 0;
+    // Nada que simular: la ejecución "empieza" donde acabó la anterior
+    if (rs->dirty == INT_MAX) {
+        const timeline_t *tl = &rs->timeline;
+        rs->resumed_at = tl->count > 0
+            ? tl->events[tl->count - 1].time + tl->events[tl->count - 1].duration : 0;
+        return 0;
+    }
+
+    // Última instantánea anterior a la primera llegada tocada
+    int lo = 0, hi = rs->num_snaps;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (rs->snaps[mid].time < rs->dirty)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    drop_snaps(rs, lo);
+
+    rs->tap = tap;
+    rs->sink.on_event = resim_event;
+    rs->sink.flush = resim_flush;
+    rs->sink.ctx = rs;
+    if (sched_init(&rs->st, rs->alg, &rs->pt, rs->quantum, rs->config, NULL,
+                   &rs->sink) != 0)
+        return -1;
+    rs->resumed_at = 0;
+    if (lo > 0) {
+        const sched_snapshot_t *snap = &rs->snaps[lo - 1];
+        if (sched_restore(&rs->st, snap) != 0) {
+            sched_finish(&rs->st, NULL);
+            return -1;
+        }
+        rs->resumed_at = snap->time;
+        timeline_truncate(&rs->timeline, snap->time);
+    } else {
+        timeline_clear(&rs->timeline);
+    }
+
+    // completion = 0 hasta que terminen en esta ejecución, para que una
+    // interrumpida no deje resultados de la anterior.  La tabla está
+    // ordenada por llegada: los admitidos son los primeros.
+    int admitted = lo > 0 ? rs->snaps[lo - 1].next : 0;
+    for (int i = admitted; i < rs->pt.n; i++)
+        rs->pt.completion[i] = 0;
+    if (lo > 0)
+        for (int k = 0; k < rs->snaps[lo - 1].num_active; k++)
+            rs->pt.completion[rs->snaps[lo - 1].job[k].idx] = 0;
+
+    // Las instantáneas siguen contando decisiones desde el principio, así
+    // que una ejecución reanudada las toma en los mismos puntos
+    rs->step = lo > 0 ? (long long)lo * rs->every : 0;
+    rs->failed = 0;
+    rs->running = 1;
+    return 0;
+}
+
+long long resim_advance(resim_t *rs, long long k) {
+    if (!rs->running)
+        return 0;
+    long long total = 0;
+    while (total < k) {
+        long long chunk = rs->every - rs->step % rs->every;
+        if (chunk > k - total)
+            chunk = k - total;
+        long long done = sched_step_events(&rs->st, chunk);
+        if (done < 0) {
+            rs->failed = 1;
+            break;
+        }
+        total += done;
+        rs->step += done;
+        if (done < chunk || sched_done(&rs->st))
+            break;
+        if (rs->step % rs->every != 0)
+            continue;
+        if (rs->num_snaps == RESIM_MAX_SNAPS)
+            thin_snaps(rs);
+        if (rs->step % rs->every == 0 &&
+            sched_save(&rs->st, &rs->snaps[rs->num_snaps]) == 0)
+            rs->num_snaps++;
+    }
+    rs->steps += total;
+    if (rs->tap)
+        sched_flush(&rs->st);
+    return total;
+}
+
+int resim_end(resim_t *rs) {
+    if (!rs->running)
+        return rs->dirty == INT_MAX;
+    int finished = sched_done(&rs->st);
+    int time = rs->st.sim.time;
+    rs->tap = NULL;         // Ya tiene todo: resim_advance lo vació
+    if (sched_finish(&rs->st, &rs->stats) != 0)
+        rs->failed = 1;
+    rs->running = 0;
+
+    // Sin memoria a medias la línea de tiempo puede tener huecos: la
+    // siguiente ejecución empieza desde 0
+    if (rs->failed) {
+        rs->dirty = 0;
+        return -1;
+    }
+    // Interrumpida: lo simulado antes de `time` sigue valiendo
+    rs->dirty = finished ? INT_MAX : time;
+    return finished;
+}
+
+int resim_run(resim_t *rs) {
+    if (resim_begin(rs, NULL) != 0)
+        return -1;
+    resim_advance(rs, LLONG_MAX);
+    return resim_end(rs) < 0 ? -1 : 0;
+}
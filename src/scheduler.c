@@ -0,0 +1,725 @@
+// -----------------------------
+// Simulador por lotes sin interfaz
+// -----------------------------
+// Carga un workload en una tabla SoA (proctable.h), ejecuta sobre ella uno
+// o varios algoritmos e imprime las métricas y los tiempos de reloj en CSV
+// o JSON.  No hay límites de tamaño fijos; cada proceso ocupa 28 bytes
+// mientras se simula.
+//
+// Uso:
+//   scheduler_cli [opciones] workload
+//     El workload puede ser texto ("pid arrival burst priority" por línea,
+//     seguido de pares "io burst" opcionales si el proceso se bloquea en
+//     E/S) o el formato binario de workload.h; se distingue por la cabecera.
+//     -a LISTA  algoritmos separados por comas: fifo,sjf,stcf,rr,mlfq o all
+//               (por defecto all)
+//     -q N      quantum de RR (por defecto 3)
+//     -Q LISTA  quantum de cada nivel de MLFQ, p. ej. 2,4,8 (por defecto 2,4,8)
+//     -A LISTA  cuota (allotment) de cada nivel de MLFQ (por defecto un quantum)
+//     -b N      intervalo de boost de MLFQ, 0 lo desactiva (por defecto 50)
+//     -f FMT    formato de salida: csv o json (por defecto csv)
+//     -o FILE   escribe en FILE en lugar de stdout
+//     -c FILE   convierte el workload a FILE (binario si acaba en .bin,
+//               texto si no) y sale sin simular
+//     -r FILE   escribe en FILE el informe comparativo en Markdown (todos
+//               los algoritmos, en paralelo) en lugar de las métricas
+//     -s SPEC   barrido de parámetros en lugar de una ejecución: cada
+//               quantum de RR y configuración de MLFQ de los rangos, p. ej.
+//               "q=1:20,levels=2:4,base=1:8,growth=1:3,boost=0:400:100"
+//               (ver sweep_spec_parse en sweep.h; "-s default" usa los
+//               valores por defecto).  Imprime una fila por configuración
+//               con una columna pareto que marca el frente de turnaround
+//               medio frente a respuesta p99.
+//     -R K      modo Monte Carlo (requiere -g): simula K workloads
+//               independientes generados con SPEC (semillas derivadas de la
+//               suya) e imprime la media, la desviación típica y el
+//               intervalo de confianza del 95% de cada métrica por algoritmo
+//     -j N      hilos para -s, -R y -P con push/steal (por defecto todos
+//               los núcleos)
+//     -P N      simula N CPUs con una cola de listos cada una (ver smp.h);
+//               la salida añade la utilización de cada CPU y las migraciones
+//     -B MODO   reparto entre CPUs: global (una cola compartida), push
+//               (migraciones periódicas) o steal (las CPUs ociosas roban;
+//               por defecto)
+//     -I N      intervalo del reparto push (por defecto 10)
+//     -C S[:P[:D]]  coste del cambio de contexto (ver switch_cost_t en
+//               scheduler.h): S unidades por cambio más una recarga de caché
+//               de hasta P que llega al máximo tras D unidades fuera de la
+//               CPU (D = 0: siempre P entero).  Se aplica a las ejecuciones
+//               normales, a -s y a -R, no a -P.  Los cambios se cuentan
+//               aunque no haya -C.
+//     -g SPEC   genera un workload sintético en lugar de leerlo, p. ej.
+//               "n=1000000,seed=7,arrival=mmpp,burst=pareto,alpha=1.5,prio=6:3:1"
+//               (ver gen_spec_parse en generator.h).  Con -c los registros
+//               van directamente al archivo.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "workload.h"
+#include "generator.h"
+#include "report.h"
+#include "sweep.h"
+#include "replicate.h"
+#include "smp.h"
+
+typedef struct {
+    sched_alg_t alg;
+    long long events;
+    int makespan;
+    metrics_t m;
+    smp_stats_t smp;        // busy == NULL con una sola CPU
+    double sim_seconds;
+    double metrics_seconds;
+} run_result_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void count_event(void *ctx, const timeline_event_t *ev) {
+    (void)ev;
+    (*(long long *)ctx)++;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s [-a algs] [-q quantum] [-Q q1,q2,..] [-A a1,a2,..] [-b boost]\n"
+            "          [-f csv|json] [-o file] [-c convert_to] [-r report.md]\n"
+            "          [-s sweep_spec] [-R replications] [-j threads]\n"
+            "          [-P cpus] [-B global|push|steal] [-I interval]\n"
+            "          [-C switch[:penalty[:decay]]]\n"
+            "          [-g spec] [workload]\n", prog);
+}
+
+// Convierte "2,4,8" en un vector recién reservado; devuelve cuántos hay o -1
+static int parse_int_list(const char *s, int **out) {
+    int count = 1;
+    for (const char *c = s; *c; c++)
+        if (*c == ',') count++;
+    int *v = malloc(count * sizeof(int));
+    if (!v) return -1;
+
+    const char *c = s;
+    for (int i = 0; i < count; i++) {
+        char *end;
+        long x = strtol(c, &end, 10);
+        if (end == c || (*end != ',' && *end != '\0') || x <= 0) {
+            free(v);
+            return -1;
+        }
+        v[i] = (int)x;
+        c = end + 1;
+    }
+    *out = v;
+    return count;
+}
+
+// Lee "switch[:penalty[:decay]]"; -1 si está mal formado
+static int parse_switch_cost(const char *s, switch_cost_t *cost) {
+    long v[3] = { 0, 0, 0 };
+    const char *c = s;
+    for (int i = 0; i < 3; i++) {
+        char *end;
+        v[i] = strtol(c, &end, 10);
+        if (end == c || v[i] < 0 || (*end != ':' && *end != '\0'))
+            return -1;
+        if (*end == '\0')
+            break;
+        if (i == 2)
+            return -1;
+        c = end + 1;
+    }
+    cost->switch_time = (int)v[0];
+    cost->cache_penalty = (int)v[1];
+    cost->cache_decay = (int)v[2];
+    return 0;
+}
+
+// Marca en selected los algoritmos de "fifo,rr"; -1 si alguno no existe
+static int parse_algorithms(const char *s, int selected[SCHED_COUNT]) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", s);
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        if (strcmp(tok, "all") == 0) {
+            for (int i = 0; i < SCHED_COUNT; i++) selected[i] = 1;
+            continue;
+        }
+        int alg = sched_alg_parse(tok);
+        if (alg < 0) {
+            fprintf(stderr, "unknown algorithm '%s'\n", tok);
+            return -1;
+        }
+        selected[alg] = 1;
+    }
+    return 0;
+}
+
+static int run_one(sched_alg_t alg, proc_table_t *pt, int quantum,
+                   mlfq_config_t *config, const switch_cost_t *cost,
+                   const smp_config_t *smp, run_result_t *r) {
+    r->alg = alg;
+    r->events = 0;
+    r->smp.busy = NULL;
+    timeline_sink_t sink = { count_event, NULL, &r->events };
+    switch_stats_t switches;
+
+    // Los motores no tocan los campos de entrada: la tabla se reutiliza
+    // entre algoritmos sin copiarla
+    double t0 = now_seconds();
+    if (smp) {
+        if (smp_run(alg, pt, quantum, config, smp, &sink, &r->smp) != 0)
+            return -1;
+    } else if (schedule_run_table_cost(alg, pt, quantum, config, cost, &sink,
+                                       &switches) != 0) {
+        return -1;
+    }
+    double t1 = now_seconds();
+
+    r->makespan = proc_table_makespan(pt);
+    if (smp) {
+        smp_metrics(pt, &r->smp, &r->m);
+    } else {
+        calculate_metrics_table(pt, r->makespan, &r->m);
+        metrics_add_switches(&r->m, &switches, r->makespan);
+    }
+    r->sim_seconds = t1 - t0;
+    r->metrics_seconds = now_seconds() - t1;
+    return 0;
+}
+
+// Utilización de cada CPU separada por sep
+static void print_cpu_utilization(FILE *out, const run_result_t *r, const char *sep) {
+    if (!r->smp.busy) {
+        fprintf(out, "%.4f", r->m.cpu_utilization);
+        return;
+    }
+    for (int c = 0; c < r->smp.num_cpus; c++)
+        fprintf(out, "%s%.4f", c ? sep : "", smp_cpu_utilization(&r->smp, c));
+}
+
+static void print_csv_header(FILE *out) {
+    fprintf(out, "algorithm,processes,events,makespan,"
+                 "avg_turnaround,avg_waiting,avg_response,"
+                 "cpu_utilization,throughput,fairness");
+    const char *names[3] = { "turnaround", "waiting", "response" };
+    for (int k = 0; k < 3; k++)
+        fprintf(out, ",%s_p50,%s_p95,%s_p99,%s_p999,%s_max",
+                names[k], names[k], names[k], names[k], names[k]);
+    fprintf(out, ",cpus,migrations,per_cpu_utilization,context_switches,"
+                 "switch_overhead,effective_utilization,sim_seconds,metrics_seconds\n");
+}
+
+static void print_csv_row(FILE *out, int n, const run_result_t *r) {
+    const metrics_t *m = &r->m;
+    fprintf(out, "%s,%d,%lld,%d,%.4f,%.4f,%.4f,%.4f,%.6f,%.6f",
+            sched_alg_name(r->alg), n, r->events, r->makespan,
+            m->avg_turnaround_time, m->avg_waiting_time, m->avg_response_time,
+            m->cpu_utilization, m->throughput, m->fairness_index);
+    const latency_summary_t *l[3] = { &m->turnaround, &m->waiting, &m->response };
+    for (int k = 0; k < 3; k++)
+        fprintf(out, ",%d,%d,%d,%d,%d",
+                l[k]->p50, l[k]->p95, l[k]->p99, l[k]->p999, l[k]->max);
+    fprintf(out, ",%d,%lld,", m->num_cpus, m->migrations);
+    print_cpu_utilization(out, r, ":");
+    fprintf(out, ",%lld,%lld,%.4f,%.6f,%.6f\n", m->context_switches,
+            m->switch_overhead, m->effective_utilization,
+            r->sim_seconds, r->metrics_seconds);
+}
+
+// Cadena JSON entre comillas, con las comillas, las barras invertidas y
+// los caracteres de control escapados: la ruta del workload puede
+// contener cualquier cosa
+static void print_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\')
+            fprintf(out, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(out, "\\u%04x", c);
+        else
+            fputc(c, out);
+    }
+    fputc('"', out);
+}
+
+static void print_json_latency(FILE *out, const char *name,
+                               const latency_summary_t *l) {
+    fprintf(out, "\"%s\": {\"p50\": %d, \"p95\": %d, \"p99\": %d, "
+                 "\"p999\": %d, \"max\": %d}",
+            name, l->p50, l->p95, l->p99, l->p999, l->max);
+}
+
+static void print_json_row(FILE *out, const run_result_t *r) {
+    const metrics_t *m = &r->m;
+    fprintf(out, "    {\"algorithm\": \"%s\", \"events\": %lld, \"makespan\": %d, "
+                 "\"avg_turnaround\": %.4f, \"avg_waiting\": %.4f, "
+                 "\"avg_response\": %.4f, \"cpu_utilization\": %.4f, "
+                 "\"throughput\": %.6f, \"fairness\": %.6f, ",
+            sched_alg_name(r->alg), r->events, r->makespan,
+            m->avg_turnaround_time, m->avg_waiting_time, m->avg_response_time,
+            m->cpu_utilization, m->throughput, m->fairness_index);
+    print_json_latency(out, "turnaround", &m->turnaround);
+    fprintf(out, ", ");
+    print_json_latency(out, "waiting", &m->waiting);
+    fprintf(out, ", ");
+    print_json_latency(out, "response", &m->response);
+    fprintf(out, ", \"cpus\": %d, \"migrations\": %lld, \"per_cpu_utilization\": [",
+            m->num_cpus, m->migrations);
+    print_cpu_utilization(out, r, ", ");
+    fprintf(out, "], \"context_switches\": %lld, \"switch_overhead\": %lld, "
+                 "\"effective_utilization\": %.4f, \"sim_seconds\": %.6f, "
+                 "\"metrics_seconds\": %.6f}",
+            m->context_switches, m->switch_overhead, m->effective_utilization,
+            r->sim_seconds, r->metrics_seconds);
+}
+
+// -----------------------------
+// Barrido de parámetros (-s)
+// -----------------------------
+static void print_sweep_csv(FILE *out, const sweep_result_t *results, int count) {
+    fprintf(out, "config,algorithm,quantum,levels,quanta,boost,makespan,"
+                 "avg_turnaround,avg_waiting,avg_response,turnaround_p99,"
+                 "response_p99,response_max,throughput,fairness,context_switches,"
+                 "switch_overhead,effective_utilization,sim_seconds,pareto\n");
+    for (int i = 0; i < count; i++) {
+        const sweep_result_t *r = &results[i];
+        const metrics_t *m = &r->metrics;
+        char label[256], quanta[192] = "";
+        sweep_label(r, label, sizeof(label));
+        for (int k = 0, off = 0; k < r->num_queues; k++)
+            off += snprintf(quanta + off, sizeof(quanta) - off, k ? ":%d" : "%d",
+                            r->quantums[k]);
+        fprintf(out, "%s,%s,%d,%d,%s,%d,%d,%.4f,%.4f,%.4f,%d,%d,%d,%.6f,%.6f,"
+                     "%lld,%lld,%.4f,%.6f,%d\n",
+                label, sched_alg_name(r->alg), r->quantum, r->num_queues, quanta,
+                r->boost_interval, r->makespan, m->avg_turnaround_time,
+                m->avg_waiting_time, m->avg_response_time, m->turnaround.p99,
+                m->response.p99, m->response.max, m->throughput, m->fairness_index,
+                m->context_switches, m->switch_overhead, m->effective_utilization,
+                r->sim_seconds, r->pareto);
+    }
+}
+
+static void print_sweep_json(FILE *out, const char *path, int n,
+                             const sweep_result_t *results, int count,
+                             const int *front, int front_size) {
+    char label[256];
+    fprintf(out, "{\n  \"workload\": ");
+    print_json_string(out, path);
+    fprintf(out, ",\n  \"processes\": %d,\n  \"configs\": [\n", n);
+    for (int i = 0; i < count; i++) {
+        const sweep_result_t *r = &results[i];
+        const metrics_t *m = &r->metrics;
+        sweep_label(r, label, sizeof(label));
+        fprintf(out, "    {\"config\": \"%s\", \"makespan\": %d, "
+                     "\"avg_turnaround\": %.4f, \"avg_waiting\": %.4f, "
+                     "\"avg_response\": %.4f, \"throughput\": %.6f, "
+                     "\"context_switches\": %lld, \"switch_overhead\": %lld, "
+                     "\"effective_utilization\": %.4f, ",
+                label, r->makespan, m->avg_turnaround_time, m->avg_waiting_time,
+                m->avg_response_time, m->throughput, m->context_switches,
+                m->switch_overhead, m->effective_utilization);
+        print_json_latency(out, "response", &m->response);
+        fprintf(out, ", \"sim_seconds\": %.6f, \"pareto\": %s}%s\n",
+                r->sim_seconds, r->pareto ? "true" : "false",
+                i + 1 < count ? "," : "");
+    }
+    fprintf(out, "  ],\n  \"pareto_front\": [");
+    for (int k = 0; k < front_size; k++) {
+        sweep_label(&results[front[k]], label, sizeof(label));
+        fprintf(out, "%s\"%s\"", k ? ", " : "", label);
+    }
+    fprintf(out, "]\n}\n");
+}
+
+static int by_turnaround(const void *a, const void *b, const sweep_result_t *results) {
+    double x = results[*(const int *)a].metrics.avg_turnaround_time;
+    double y = results[*(const int *)b].metrics.avg_turnaround_time;
+    return (x > y) - (x < y);
+}
+
+static int run_sweep(const sweep_spec_t *spec, const proc_table_t *pt,
+                     const char *path, int threads, int json, const char *out_path) {
+    int count = sweep_count(spec);
+    if (count <= 0) {
+        fprintf(stderr, "sweep spec selects no configurations\n");
+        return 1;
+    }
+    sweep_result_t *results = malloc(count * sizeof(sweep_result_t));
+    int *front = malloc(count * sizeof(int));
+    if (!results || !front || sweep_run(spec, pt, threads, results) != 0) {
+        perror("sweep");
+        free(results);
+        free(front);
+        return 1;
+    }
+
+    // Frente ordenado por turnaround medio (insertion sort: suele ser corto)
+    int front_size = 0;
+    for (int i = 0; i < count; i++) {
+        if (!results[i].pareto) continue;
+        int k = front_size++;
+        while (k > 0 && by_turnaround(&front[k - 1], &i, results) > 0) {
+            front[k] = front[k - 1];
+            k--;
+        }
+        front[k] = i;
+    }
+
+    FILE *out = stdout;
+    if (out_path && !(out = fopen(out_path, "w"))) {
+        perror(out_path);
+        free(results);
+        free(front);
+        return 1;
+    }
+    if (json)
+        print_sweep_json(out, path, pt->n, results, count, front, front_size);
+    else
+        print_sweep_csv(out, results, count);
+    if (out != stdout) fclose(out);
+
+    fprintf(stderr, "pareto front (%d of %d configurations):\n", front_size, count);
+    for (int k = 0; k < front_size; k++) {
+        char label[256];
+        const sweep_result_t *r = &results[front[k]];
+        sweep_label(r, label, sizeof(label));
+        fprintf(stderr, "  %-32s avg turnaround %.2f  p99 response %d\n",
+                label, r->metrics.avg_turnaround_time, r->metrics.response.p99);
+    }
+    free(results);
+    free(front);
+    return 0;
+}
+
+// -----------------------------
+// Réplicas Monte Carlo (-R)
+// -----------------------------
+static int run_replications(const gen_spec_t *spec, int k,
+                            const int selected[SCHED_COUNT], int quantum,
+                            mlfq_config_t *config, const switch_cost_t *cost,
+                            int threads, int json, const char *out_path) {
+    metrics_t *runs = malloc((size_t)k * SCHED_COUNT * sizeof(metrics_t));
+    if (!runs) {
+        perror("malloc");
+        return 1;
+    }
+    double t0 = now_seconds();
+    char err[256];
+    if (replicate_run(spec, k, selected, quantum, config, cost, threads, runs,
+                      err, sizeof(err)) != 0) {
+        fprintf(stderr, "%s\n", err);
+        free(runs);
+        return 1;
+    }
+    double elapsed = now_seconds() - t0;
+
+    FILE *out = stdout;
+    if (out_path && !(out = fopen(out_path, "w"))) {
+        perror(out_path);
+        free(runs);
+        return 1;
+    }
+    if (json)
+        fprintf(out, "{\n  \"replications\": %d,\n  \"processes\": %lld,\n"
+                     "  \"seed\": %llu,\n  \"seconds\": %.6f,\n  \"results\": [\n",
+                k, spec->count, (unsigned long long)spec->seed, elapsed);
+    else
+        fprintf(out, "algorithm,metric,replications,mean,stddev,ci95_lo,ci95_hi\n");
+
+    int first = 1;
+    for (int alg = 0; alg < SCHED_COUNT; alg++) {
+        if (!selected[alg]) continue;
+        rep_stat_t stats[REP_METRICS];
+        rep_summarize(runs + alg, k, SCHED_COUNT, stats);
+        if (json)
+            fprintf(out, "%s    {\"algorithm\": \"%s\", \"metrics\": {",
+                    first ? "" : ",\n", sched_alg_name(alg));
+        for (int i = 0; i < REP_METRICS; i++) {
+            const rep_stat_t *st = &stats[i];
+            if (json)
+                fprintf(out, "%s\"%s\": {\"mean\": %.6f, \"stddev\": %.6f, "
+                             "\"ci95\": [%.6f, %.6f]}",
+                        i ? ", " : "", rep_metric_name(i), st->mean, st->stddev,
+                        st->ci_lo, st->ci_hi);
+            else
+                fprintf(out, "%s,%s,%d,%.6f,%.6f,%.6f,%.6f\n",
+                        sched_alg_name(alg), rep_metric_name(i), k, st->mean,
+                        st->stddev, st->ci_lo, st->ci_hi);
+        }
+        if (json)
+            fprintf(out, "}}");
+        first = 0;
+    }
+    if (json)
+        fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) fclose(out);
+
+    fprintf(stderr, "%d replications in %.3f s (%.1f replications/s)\n",
+            k, elapsed, elapsed > 0 ? k / elapsed : 0.0);
+    free(runs);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int selected[SCHED_COUNT] = {0};
+    int any_selected = 0;
+    int quantum = 3;
+    int default_quantums[] = {2, 4, 8};
+    int *quantums = default_quantums, num_queues = 3;
+    int *allotments = NULL, num_allotments = 0;
+    int boost = 50;
+    int json = 0;
+    const char *out_path = NULL;
+    const char *convert_path = NULL;
+    const char *gen_text = NULL;
+    const char *report_path = NULL;
+    const char *sweep_text = NULL;
+    int threads = 0;
+    int replications = 0;
+    smp_config_t smp;
+    int use_smp = 0;
+    switch_cost_t cost = { 0, 0, 0 };
+    int use_cost = 0;
+    char err[512];
+
+    smp_config_default(&smp);
+    int opt;
+    while ((opt = getopt(argc, argv, "a:q:Q:A:b:f:o:c:g:r:s:R:j:P:B:I:C:h")) != -1) {
+        switch (opt) {
+            case 'a':
+                if (parse_algorithms(optarg, selected) != 0) return 1;
+                any_selected = 1;
+                break;
+            case 'q':
+                quantum = atoi(optarg);
+                if (quantum < 1) { fprintf(stderr, "quantum must be >= 1\n"); return 1; }
+                break;
+            case 'Q':
+                num_queues = parse_int_list(optarg, &quantums);
+                if (num_queues < 0) { fprintf(stderr, "bad MLFQ quantum list '%s'\n", optarg); return 1; }
+                break;
+            case 'A':
+                num_allotments = parse_int_list(optarg, &allotments);
+                if (num_allotments < 0) { fprintf(stderr, "bad MLFQ allotment list '%s'\n", optarg); return 1; }
+                break;
+            case 'b':
+                boost = atoi(optarg);
+                break;
+            case 'f':
+                if (strcmp(optarg, "json") == 0) json = 1;
+                else if (strcmp(optarg, "csv") == 0) json = 0;
+                else { fprintf(stderr, "unknown format '%s'\n", optarg); return 1; }
+                break;
+            case 'o':
+                out_path = optarg;
+                break;
+            case 'c':
+                convert_path = optarg;
+                break;
+            case 'g':
+                gen_text = optarg;
+                break;
+            case 'r':
+                report_path = optarg;
+                break;
+            case 's':
+                sweep_text = optarg;
+                break;
+            case 'R':
+                replications = atoi(optarg);
+                if (replications < 1) { fprintf(stderr, "replications must be >= 1\n"); return 1; }
+                break;
+            case 'j':
+                threads = atoi(optarg);
+                break;
+            case 'P':
+                smp.num_cpus = atoi(optarg);
+                if (smp.num_cpus < 1) { fprintf(stderr, "cpus must be >= 1\n"); return 1; }
+                use_smp = 1;
+                break;
+            case 'B':
+                smp.balance = smp_balance_parse(optarg);
+                if ((int)smp.balance < 0) { fprintf(stderr, "unknown balancing '%s'\n", optarg); return 1; }
+                use_smp = 1;
+                break;
+            case 'I':
+                smp.balance_interval = atoi(optarg);
+                if (smp.balance_interval < 1) { fprintf(stderr, "balance interval must be >= 1\n"); return 1; }
+                use_smp = 1;
+                break;
+            case 'C':
+                if (parse_switch_cost(optarg, &cost) != 0) { fprintf(stderr, "bad switch cost '%s'\n", optarg); return 1; }
+                use_cost = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - (gen_text ? 0 : 1)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (!any_selected)
+        for (int i = 0; i < SCHED_COUNT; i++) selected[i] = 1;
+    if (allotments && num_allotments != num_queues) {
+        fprintf(stderr, "-A needs one allotment per MLFQ level (%d)\n", num_queues);
+        return 1;
+    }
+    mlfq_config_t config = { num_queues, quantums, boost, allotments };
+    if (replications > 0 && !gen_text) {
+        fprintf(stderr, "-R needs a workload spec (-g)\n");
+        return 1;
+    }
+    if (use_smp && (replications > 0 || sweep_text || report_path)) {
+        fprintf(stderr, "-P/-B/-I only apply to plain simulation runs\n");
+        return 1;
+    }
+    if (use_cost && (use_smp || report_path)) {
+        fprintf(stderr, "-C does not apply to -P or -r\n");
+        return 1;
+    }
+    smp.threads = threads;
+
+    sweep_spec_t sweep;
+    sweep_spec_default(&sweep);
+    if (sweep_text && strcmp(sweep_text, "default") != 0 &&
+        sweep_spec_parse(&sweep, sweep_text, err, sizeof(err)) != 0) {
+        fprintf(stderr, "%s\n", err);
+        return 1;
+    }
+    sweep.cost = cost;
+
+    size_t convert_len = convert_path ? strlen(convert_path) : 0;
+    int convert_binary = convert_len >= 4 &&
+                         strcmp(convert_path + convert_len - 4, ".bin") == 0;
+
+    gen_spec_t spec;
+    if (gen_text) {
+        gen_spec_default(&spec);
+        if (gen_spec_parse(&spec, gen_text, err, sizeof(err)) != 0) {
+            fprintf(stderr, "%s\n", err);
+            return 1;
+        }
+        if (replications > 0)
+            return run_replications(&spec, replications, selected, quantum,
+                                    &config, &cost, threads, json, out_path);
+        if (convert_path) {
+            int rc = generate_to_file(&spec, convert_path, convert_binary,
+                                      err, sizeof(err));
+            if (rc != 0)
+                fprintf(stderr, "%s\n", err);
+            return rc != 0;
+        }
+    }
+
+    const char *path = gen_text ? "generated" : argv[optind];
+    if (convert_path || report_path) {
+        workload_t wl;
+        workload_init(&wl);
+        int loaded = gen_text ? generate_workload(&spec, &wl, err, sizeof(err))
+                              : workload_load(path, &wl, err, sizeof(err));
+        if (loaded != 0) {
+            fprintf(stderr, "%s\n", err);
+            workload_free(&wl);
+            return 1;
+        }
+        int rc = 0;
+        if (convert_path) {
+            rc = convert_binary
+                ? workload_save_binary(convert_path, wl.processes, wl.n, err, sizeof(err))
+                : workload_save_text(convert_path, wl.processes, wl.n, err, sizeof(err));
+            if (rc != 0)
+                fprintf(stderr, "%s\n", err);
+        } else if (wl.n == 0) {
+            fprintf(stderr, "%s: empty workload\n", path);
+            rc = 1;
+        } else {
+            generate_report(report_path, wl.processes, wl.n);
+        }
+        workload_free(&wl);
+        return rc != 0;
+    }
+
+    // Para simular basta la tabla SoA: no se guarda ningún process_t[]
+    proc_table_t pt;
+    double t0 = now_seconds();
+    int loaded = gen_text ? generate_table(&spec, &pt, err, sizeof(err))
+                          : proc_table_load(path, &pt, err, sizeof(err));
+    if (loaded != 0) {
+        fprintf(stderr, "%s\n", err);
+        return 1;
+    }
+    double load_seconds = now_seconds() - t0;
+    if (pt.n == 0) {
+        fprintf(stderr, "%s: empty workload\n", path);
+        proc_table_free(&pt);
+        return 1;
+    }
+    if (use_smp && pt.first) {
+        fprintf(stderr, "-P does not model I/O bursts\n");
+        proc_table_free(&pt);
+        return 1;
+    }
+
+    if (sweep_text) {
+        int rc = run_sweep(&sweep, &pt, path, threads, json, out_path);
+        proc_table_free(&pt);
+        return rc;
+    }
+
+    FILE *out = stdout;
+    if (out_path && !(out = fopen(out_path, "w"))) {
+        perror(out_path);
+        proc_table_free(&pt);
+        return 1;
+    }
+
+    if (json) {
+        fprintf(out, "{\n  \"workload\": ");
+        print_json_string(out, path);
+        fprintf(out, ",\n  \"processes\": %d,\n  \"load_seconds\": %.6f,\n"
+                     "  \"runs\": [\n", pt.n, load_seconds);
+    } else {
+        print_csv_header(out);
+    }
+
+    int first = 1, rc = 0;
+    for (int alg = 0; alg < SCHED_COUNT; alg++) {
+        if (!selected[alg]) continue;
+        run_result_t r;
+        if (run_one(alg, &pt, quantum, &config, &cost, use_smp ? &smp : NULL, &r) != 0) {
+            fprintf(stderr, "out of memory simulating %s\n", sched_alg_name(alg));
+            rc = 1;
+            break;
+        }
+        if (json) {
+            if (!first) fprintf(out, ",\n");
+            print_json_row(out, &r);
+        } else {
+            print_csv_row(out, pt.n, &r);
+        }
+        smp_stats_free(&r.smp);
+        first = 0;
+    }
+    if (json)
+        fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    proc_table_free(&pt);
+    if (quantums != default_quantums) free(quantums);
+    free(allotments);
+    return rc;
+}
@@ -0,0 +1,349 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "simd.h"
+#include "histogram.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// -----------------------------
+// Selección del nivel
+// -----------------------------
+static simd_level_t detect_level(void) {
+    simd_level_t level = SIMD_SCALAR;
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))
+        level = SIMD_SSE2;
+    if (__builtin_cpu_supports("avx2"))
+        level = SIMD_AVX2;
+#endif
+    const char *cap = getenv("SCHED_SIMD");
+    if (cap) {
+        simd_level_t max = level;
+        if (strcmp(cap, "scalar") == 0) max = SIMD_SCALAR;
+        else if (strcmp(cap, "sse2") == 0) max = SIMD_SSE2;
+        else if (strcmp(cap, "avx2") == 0) max = SIMD_AVX2;
+        if (max < level)
+            level = max;
+    }
+    return level;
+}
+
+simd_level_t simd_level(void) {
+    // Varios hilos pueden calcularlo a la vez: todos obtienen el mismo valor
+    static int cached = -1;
+    int level = __atomic_load_n(&cached, __ATOMIC_RELAXED);
+    if (level < 0) {
+        level = detect_level();
+        __atomic_store_n(&cached, level, __ATOMIC_RELAXED);
+    }
+    return (simd_level_t)level;
+}
+
+const char *simd_level_name(simd_level_t level) {
+    switch (level) {
+        case SIMD_SSE2: return "sse2";
+        case SIMD_AVX2: return "avx2";
+        default:        return "scalar";
+    }
+}
+
+void simd_sums_init(simd_sums_t *s) {
+    memset(s, 0, sizeof(*s));
+    for (int k = 0; k < 3; k++) {
+        s->min[k] = INT_MAX;
+        s->max[k] = 0;
+    }
+}
+
+// -----------------------------
+// Métricas: versión escalar
+// -----------------------------
+// También termina los elementos que sobran de las versiones vectoriales;
+// i es el índice dentro del bloque (from es múltiplo de 4, así que i % 4
+// es el carril global).
+static void latency_scalar(const proc_table_t *pt, int from, int i, int n,
+                           simd_sums_t *s, int *buckets) {
+    const int *arrival = pt->arrival + from, *burst = pt->burst + from;
+    const int *start = pt->start + from, *completion = pt->completion + from;
+    int tmin = s->min[0], tmax = s->max[0], wmin = s->min[1], wmax = s->max[1];
+    int rmin = s->min[2], rmax = s->max[2];
+    for (; i < n; i++) {
+        int t = completion[i] - arrival[i];
+        int w = t - burst[i];
+        int r = start[i] - arrival[i];
+        s->turnaround += t;
+        s->waiting += w;
+        s->response += r;
+        s->busy += burst[i];
+        s->turnaround2[i & 3] += (double)t * t;
+
+        t = t < 0 ? 0 : t;
+        w = w < 0 ? 0 : w;
+        r = r < 0 ? 0 : r;
+        tmin = t < tmin ? t : tmin;
+        tmax = t > tmax ? t : tmax;
+        wmin = w < wmin ? w : wmin;
+        wmax = w > wmax ? w : wmax;
+        rmin = r < rmin ? r : rmin;
+        rmax = r > rmax ? r : rmax;
+        buckets[i] = hist_bucket(t);
+        buckets[n + i] = hist_bucket(w);
+        buckets[2 * n + i] = hist_bucket(r);
+    }
+    s->min[0] = tmin; s->max[0] = tmax;
+    s->min[1] = wmin; s->max[1] = wmax;
+    s->min[2] = rmin; s->max[2] = rmax;
+}
+
+#ifdef SIMD_X86
+// -----------------------------
+// Métricas: SSE2
+// -----------------------------
+// Sumas, cuadrados y mínimo/máximo de 4 en 4; las cubetas necesitan
+// desplazamientos variables (AVX2), así que se calculan en escalar.
+__attribute__((target("sse2")))
+static inline __m128i sse2_add_i64(__m128i acc, __m128i v) {
+    __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+}
+
+__attribute__((target("sse2")))
+static inline __m128i sse2_min(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+__attribute__((target("sse2")))
+static inline __m128i sse2_max(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+__attribute__((target("sse2")))
+static void latency_sse2(const proc_table_t *pt, int from, int n,
+                         simd_sums_t *s, int *buckets) {
+    const int *arrival = pt->arrival + from, *burst = pt->burst + from;
+    const int *start = pt->start + from, *completion = pt->completion + from;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum[4] = { zero, zero, zero, zero };
+    __m128d sq01 = _mm_setzero_pd(), sq23 = _mm_setzero_pd();
+    __m128i vmin[3], vmax[3];
+    for (int k = 0; k < 3; k++) {
+        vmin[k] = _mm_set1_epi32(INT_MAX);
+        vmax[k] = zero;
+    }
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(arrival + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(burst + i));
+        __m128i t = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(completion + i)), a);
+        __m128i w = _mm_sub_epi32(t, b);
+        __m128i r = _mm_sub_epi32(_mm_loadu_si128((const __m128i *)(start + i)), a);
+        sum[0] = sse2_add_i64(sum[0], t);
+        sum[1] = sse2_add_i64(sum[1], w);
+        sum[2] = sse2_add_i64(sum[2], r);
+        sum[3] = sse2_add_i64(sum[3], b);
+
+        __m128d t01 = _mm_cvtepi32_pd(t);
+        __m128d t23 = _mm_cvtepi32_pd(_mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2)));
+        sq01 = _mm_add_pd(sq01, _mm_mul_pd(t01, t01));
+        sq23 = _mm_add_pd(sq23, _mm_mul_pd(t23, t23));
+
+        __m128i v[3] = { t, w, r };
+        for (int k = 0; k < 3; k++) {
+            v[k] = sse2_max(v[k], zero);
+            vmin[k] = sse2_min(vmin[k], v[k]);
+            vmax[k] = sse2_max(vmax[k], v[k]);
+            int x[4];
+            _mm_storeu_si128((__m128i *)x, v[k]);
+            for (int j = 0; j < 4; j++)
+                buckets[k * n + i + j] = hist_bucket(x[j]);
+        }
+    }
+
+    long long lanes[2];
+    long long *dst[4] = { &s->turnaround, &s->waiting, &s->response, &s->busy };
+    for (int k = 0; k < 4; k++) {
+        _mm_storeu_si128((__m128i *)lanes, sum[k]);
+        *dst[k] += lanes[0] + lanes[1];
+    }
+    double sq[4];
+    _mm_storeu_pd(sq, sq01);
+    _mm_storeu_pd(sq + 2, sq23);
+    for (int k = 0; k < 4; k++)
+        s->turnaround2[k] += sq[k];
+    for (int k = 0; k < 3; k++) {
+        int lo[4], hi[4];
+        _mm_storeu_si128((__m128i *)lo, vmin[k]);
+        _mm_storeu_si128((__m128i *)hi, vmax[k]);
+        for (int j = 0; j < 4; j++) {
+            if (lo[j] < s->min[k]) s->min[k] = lo[j];
+            if (hi[j] > s->max[k]) s->max[k] = hi[j];
+        }
+    }
+    latency_scalar(pt, from, i, n, s, buckets);
+}
+
+// -----------------------------
+// Métricas: AVX2
+// -----------------------------
+// Cubeta de 8 valores >= 0 a la vez.  El exponente de (float)v da el bit
+// más alto salvo cuando el redondeo sube a la siguiente potencia de 2;
+// en ese caso v >> e es 0 y se corrige restando 1.
+__attribute__((target("avx2")))
+static inline __m256i avx2_bucket(__m256i v) {
+    __m256i one = _mm256_set1_epi32(1);
+    __m256 f = _mm256_cvtepi32_ps(_mm256_or_si256(v, one));
+    __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(f), 23),
+                                 _mm256_set1_epi32(127));
+    __m256i over = _mm256_cmpeq_epi32(_mm256_srlv_epi32(_mm256_or_si256(v, one), e),
+                                      _mm256_setzero_si256());
+    e = _mm256_add_epi32(e, over);          // over es -1 donde hay que corregir
+    __m256i shift = _mm256_max_epi32(_mm256_sub_epi32(e, _mm256_set1_epi32(6)),
+                                     _mm256_setzero_si256());
+    return _mm256_add_epi32(_mm256_slli_epi32(shift, 6), _mm256_srlv_epi32(v, shift));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_add_i64(__m256i acc, __m256i v) {
+    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+
+__attribute__((target("avx2")))
+static void latency_avx2(const proc_table_t *pt, int from, int n,
+                         simd_sums_t *s, int *buckets) {
+    const int *arrival = pt->arrival + from, *burst = pt->burst + from;
+    const int *start = pt->start + from, *completion = pt->completion + from;
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum[4] = { zero, zero, zero, zero };
+    __m256d sq = _mm256_setzero_pd();
+    __m256i vmin[3], vmax[3];
+    for (int k = 0; k < 3; k++) {
+        vmin[k] = _mm256_set1_epi32(INT_MAX);
+        vmax[k] = zero;
+    }
+
+    // De 8 en 8: los elementos i..i+3 y luego i+4..i+7 suman sus cuadrados
+    // en los carriles 0..3, en el mismo orden que la versión escalar
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(arrival + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(burst + i));
+        __m256i t = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(completion + i)), a);
+        __m256i w = _mm256_sub_epi32(t, b);
+        __m256i r = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(start + i)), a);
+        sum[0] = avx2_add_i64(sum[0], t);
+        sum[1] = avx2_add_i64(sum[1], w);
+        sum[2] = avx2_add_i64(sum[2], r);
+        sum[3] = avx2_add_i64(sum[3], b);
+
+        __m256d tlo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(t));
+        __m256d thi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(t, 1));
+        sq = _mm256_add_pd(sq, _mm256_mul_pd(tlo, tlo));
+        sq = _mm256_add_pd(sq, _mm256_mul_pd(thi, thi));
+
+        __m256i v[3] = { t, w, r };
+        for (int k = 0; k < 3; k++) {
+            v[k] = _mm256_max_epi32(v[k], zero);
+            vmin[k] = _mm256_min_epi32(vmin[k], v[k]);
+            vmax[k] = _mm256_max_epi32(vmax[k], v[k]);
+            _mm256_storeu_si256((__m256i *)(buckets + k * n + i), avx2_bucket(v[k]));
+        }
+    }
+
+    long long lanes[4];
+    long long *dst[4] = { &s->turnaround, &s->waiting, &s->response, &s->busy };
+    for (int k = 0; k < 4; k++) {
+        _mm256_storeu_si256((__m256i *)lanes, sum[k]);
+        *dst[k] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    double sq4[4];
+    _mm256_storeu_pd(sq4, sq);
+    for (int k = 0; k < 4; k++)
+        s->turnaround2[k] += sq4[k];
+    for (int k = 0; k < 3; k++) {
+        int lo[8], hi[8];
+        _mm256_storeu_si256((__m256i *)lo, vmin[k]);
+        _mm256_storeu_si256((__m256i *)hi, vmax[k]);
+        for (int j = 0; j < 8; j++) {
+            if (lo[j] < s->min[k]) s->min[k] = lo[j];
+            if (hi[j] > s->max[k]) s->max[k] = hi[j];
+        }
+    }
+    latency_scalar(pt, from, i, n, s, buckets);
+}
+#endif // SIMD_X86
+
+void simd_latency_block(const proc_table_t *pt, int from, int n,
+                        simd_sums_t *s, int *buckets) {
+#ifdef SIMD_X86
+    switch (simd_level()) {
+        case SIMD_AVX2: latency_avx2(pt, from, n, s, buckets); return;
+        case SIMD_SSE2: latency_sse2(pt, from, n, s, buckets); return;
+        default: break;
+    }
+#endif
+    latency_scalar(pt, from, 0, n, s, buckets);
+}
+
+// -----------------------------
+// argmin
+// -----------------------------
+static int argmin_scalar(const int64_t *v, int n) {
+    int best = 0;
+    for (int i = 1; i < n; i++)
+        best = v[i] < v[best] ? i : best;     // Sin saltos (cmov)
+    return best;
+}
+
+#ifdef SIMD_X86
+// Mínimo por carriles y luego la primera posición que lo alcanza
+__attribute__((target("avx2")))
+static int argmin_avx2(const int64_t *v, int n) {
+    if (n < 8)
+        return argmin_scalar(v, n);
+    __m256i m = _mm256_loadu_si256((const __m256i *)v);
+    int i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+        m = _mm256_blendv_epi8(m, x, _mm256_cmpgt_epi64(m, x));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, m);
+    int64_t min = lanes[0];
+    for (int k = 1; k < 4; k++)
+        min = lanes[k] < min ? lanes[k] : min;
+    for (; i < n; i++)
+        min = v[i] < min ? v[i] : min;
+
+    __m256i target = _mm256_set1_epi64x(min);
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(v + i)), target);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    for (; v[i] != min; i++)
+        ;
+    return i;
+}
+#endif
+
+int simd_argmin_i64(const int64_t *v, int n) {
+    if (n <= 0)
+        return -1;
+#ifdef SIMD_X86
+    // pcmpgtq no está en SSE2: ese nivel usa la versión escalar
+    if (simd_level() == SIMD_AVX2)
+        return argmin_avx2(v, n);
+#endif
+    return argmin_scalar(v, n);
+}
@@ -0,0 +1,843 @@
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include "smp.h"
+#include "engine.h"
+#include "heap.h"
+#include "queue.h"
+#include "mlfq.h"
+#include "pool.h"
+
+// -----------------------------
+// Estado
+// -----------------------------
+// Cola de listos: la global (SMP_GLOBAL) o la de una CPU.  Sólo se usa el
+// miembro de la política en curso.
+typedef struct {
+    queue_t q;              // FIFO y RR
+    heap_t h;               // SJF y STCF
+    mlfq_levels_t lv;       // MLFQ
+    long long work;         // Tiempo restante de los procesos en cola
+} smp_rq_t;
+
+typedef struct {
+    int idx;                // Proceso en ejecución, -1 = libre
+    int since;              // Inicio del tramo en curso
+    int until;              // Fin previsto del tramo (INT_MAX = libre)
+    int rq;                 // Cola de la que toma trabajo
+    int pending;            // Su cola recibió trabajo (o la CPU quedó libre)
+    int done;               // Procesos terminados en esta CPU
+    long long busy;
+    long long migrations;   // Procesos que llegaron de otra CPU
+    int last;               // Último proceso ejecutado (-1 = ninguno)
+    long long switches;     // Cambios de proceso
+    timeline_stream_t out;
+
+    // push/steal: la CPU avanza por su cuenta dentro de cada ventana
+    int cursor;             // Su siguiente posición en orden de llegada
+    int requeue;            // Expulsado que vuelve a la cola (-1 = ninguno)
+    long long next_boost;
+    timeline_t buf;         // Eventos de la ventana hasta sincronizar
+    timeline_sink_t buf_sink;
+    int failed;
+} smp_cpu_t;
+
+// Proceso expulsado que vuelve a su cola cuando ya entraron las llegadas
+typedef struct {
+    int idx;
+    int rq;
+} smp_requeue_t;
+
+typedef struct {
+    sched_alg_t alg;
+    proc_table_t *pt;
+    int quantum;
+    mlfq_config_t *config;
+    smp_balance_t balance;
+    int num_cpus;
+    int num_rqs;
+    long long boost;        // Periodo de boost de MLFQ (0 = ninguno)
+    long long interval;     // Periodo del balanceo push (0 = ninguno)
+    sim_t sim;              // Procesos en orden de llegada
+    smp_cpu_t *cpu;
+    smp_rq_t *rq;
+    int *pos;               // pos[] compartido por los heaps de SJF/STCF
+    mlfq_job_t *job;        // Estado MLFQ compartido por todas las colas
+    int *last_cpu;          // Última CPU de cada proceso (-1 = ninguna)
+    const timeline_sink_t *sink;
+
+    // SMP_GLOBAL: un único bucle de eventos
+    heap_t ends;            // CPUs ordenadas por (until, cpu)
+    smp_requeue_t *requeue;
+    int requeue_count;
+    unsigned long long *idle;       // Un bit por CPU libre
+    int words;
+    long long next_boost;
+
+    // push/steal: ventanas entre sincronizaciones
+    long long next_balance;
+    int horizon;            // Instante en que termina la ventana en curso
+    int window;             // Longitud máxima de una ventana
+    int finished;
+    pool_barrier_t barrier;
+    int *finish_at;         // steal_horizon: instante en que se vacía cada CPU
+    unsigned char *multi;   // steal_horizon: CPUs que pueden tener cola
+} smp_t;
+
+static const char *balance_names[SMP_BALANCE_COUNT] = { "global", "push", "steal" };
+
+const char *smp_balance_name(smp_balance_t balance) {
+    return (balance >= 0 && balance < SMP_BALANCE_COUNT) ? balance_names[balance] : "?";
+}
+
+int smp_balance_parse(const char *name) {
+    for (int i = 0; i < SMP_BALANCE_COUNT; i++)
+        if (strcasecmp(name, balance_names[i]) == 0)
+            return i;
+    return -1;
+}
+
+void smp_config_default(smp_config_t *cfg) {
+    cfg->num_cpus = 4;
+    cfg->balance = SMP_STEAL;
+    cfg->balance_interval = 10;
+    cfg->threads = 1;
+}
+
+// Siguiente múltiplo de interval estrictamente posterior a t
+static long long next_tick(long long t, long long interval) {
+    return interval > 0 ? (t / interval + 1) * interval : LLONG_MAX;
+}
+
+// -----------------------------
+// Colas de listos
+// -----------------------------
+static int rq_init(smp_t *s, smp_rq_t *rq) {
+    switch (s->alg) {
+        case SCHED_SJF:
+        case SCHED_STCF:
+            return heap_init_shared(&rq->h, s->pos, s->pt->n);
+        case SCHED_MLFQ:
+            return mlfq_levels_init(&rq->lv, s->config->num_queues > 0
+                                    ? s->config->num_queues : 1, s->pt->n, s->job);
+        default:
+            return queue_init(&rq->q, 64);
+    }
+}
+
+static void rq_free(smp_t *s, smp_rq_t *rq) {
+    switch (s->alg) {
+        case SCHED_SJF:
+        case SCHED_STCF: heap_free(&rq->h); break;
+        case SCHED_MLFQ: mlfq_levels_free(&rq->lv); break;
+        default:         queue_free(&rq->q); break;
+    }
+}
+
+static int rq_len(const smp_t *s, int r) {
+    const smp_rq_t *rq = &s->rq[r];
+    switch (s->alg) {
+        case SCHED_SJF:
+        case SCHED_STCF: return heap_size(&rq->h);
+        case SCHED_MLFQ: return rq->lv.count;
+        default:         return rq->q.count;
+    }
+}
+
+// MLFQ: el proceso entra en su nivel actual (arrive lo pone a 0)
+static void rq_push(smp_t *s, int r, int idx) {
+    smp_rq_t *rq = &s->rq[r];
+    const proc_table_t *pt = s->pt;
+    int rc = 0;
+    switch (s->alg) {
+        case SCHED_SJF:  rc = heap_push(&rq->h, idx, pt->burst[idx], pt->pid[idx]); break;
+        case SCHED_STCF: rc = heap_push(&rq->h, idx, pt->remaining[idx], pt->pid[idx]); break;
+        case SCHED_MLFQ: mlfq_push(&rq->lv, s->job[idx].level, idx); break;
+        default:         rc = queue_push(&rq->q, idx); break;
+    }
+    if (rc != 0)
+        s->cpu[r].failed = 1;
+    rq->work += pt->remaining[idx];
+    s->cpu[r].pending = 1;
+}
+
+static int rq_pop(smp_t *s, int r) {
+    smp_rq_t *rq = &s->rq[r];
+    int idx;
+    switch (s->alg) {
+        case SCHED_SJF:
+        case SCHED_STCF:
+            idx = heap_pop(&rq->h);
+            break;
+        case SCHED_MLFQ: {
+            int l = mlfq_top_level(&rq->lv);
+            idx = l < 0 ? -1 : mlfq_pop(&rq->lv, l);
+            break;
+        }
+        default:
+            idx = queue_pop(&rq->q);
+            break;
+    }
+    if (idx >= 0)
+        rq->work -= s->pt->remaining[idx];
+    return idx;
+}
+
+// epoch depende sólo del instante del boost, así que todas las colas
+// coinciden aunque una CPU libre no haya visto los boosts intermedios
+static void rq_boost(smp_t *s, int r, int now) {
+    mlfq_boost(&s->rq[r].lv);
+    s->rq[r].lv.epoch = (int)(now / s->boost);
+}
+
+// -----------------------------
+// Ejecución en una CPU
+// -----------------------------
+static int mlfq_quantum(const mlfq_config_t *config, int level) {
+    return config->quantums[level] > 0 ? config->quantums[level] : 1;
+}
+
+static int mlfq_allotment(const mlfq_config_t *config, int level) {
+    return (config->allotments && config->allotments[level] > 0)
+        ? config->allotments[level] : mlfq_quantum(config, level);
+}
+
+// Una CPU que queda libre vuelve a mirar su cola en el próximo despacho
+static void set_idle(smp_t *s, int c) {
+    s->cpu[c].idx = -1;
+    s->cpu[c].until = INT_MAX;
+    s->cpu[c].pending = 1;
+    if (s->balance == SMP_GLOBAL) {
+        s->idle[c / 64] |= 1ULL << (c % 64);
+        heap_update(&s->ends, c, INT_MAX);
+    }
+}
+
+// Cierra el tramo de la CPU c en el instante now; el proceso queda
+// terminado o pendiente de volver a su cola
+static void stop(smp_t *s, int c, int now) {
+    smp_cpu_t *cpu = &s->cpu[c];
+    proc_table_t *pt = s->pt;
+    int idx = cpu->idx;
+    int ran = now - cpu->since;
+
+    stream_slice(&cpu->out, cpu->since, pt->pid[idx], ran);
+    pt->remaining[idx] -= ran;
+    cpu->busy += ran;
+    set_idle(s, c);
+
+    if (pt->remaining[idx] == 0) {
+        pt->completion[idx] = now;
+        cpu->done++;
+        return;
+    }
+    if (s->alg == SCHED_MLFQ) {
+        mlfq_job_t *j = &s->job[idx];
+        j->used += ran;
+        if (j->used >= mlfq_allotment(s->config, j->level)) {
+            if (j->level < s->rq[cpu->rq].lv.num_queues - 1)
+                j->level++;
+            j->used = 0;
+        }
+    }
+    if (s->balance == SMP_GLOBAL) {
+        s->requeue[s->requeue_count].idx = idx;
+        s->requeue[s->requeue_count].rq = cpu->rq;
+        s->requeue_count++;
+    } else {
+        cpu->requeue = idx;
+    }
+}
+
+static void start(smp_t *s, int c, int idx, int now) {
+    smp_cpu_t *cpu = &s->cpu[c];
+    proc_table_t *pt = s->pt;
+
+    if (pt->remaining[idx] == pt->burst[idx])
+        pt->start[idx] = now;
+    if (s->last_cpu[idx] >= 0 && s->last_cpu[idx] != c)
+        cpu->migrations++;
+    s->last_cpu[idx] = c;
+    if (cpu->last != idx)
+        cpu->switches++;
+    cpu->last = idx;
+
+    long long slice = pt->remaining[idx];
+    if (s->alg == SCHED_RR && slice > s->quantum)
+        slice = s->quantum;
+    if (s->alg == SCHED_MLFQ) {
+        mlfq_job_t *j = &s->job[idx];
+        int quantum = mlfq_quantum(s->config, j->level);
+        int allotment = mlfq_allotment(s->config, j->level);
+        long long next_boost = s->balance == SMP_GLOBAL ? s->next_boost : cpu->next_boost;
+        if (slice > quantum)
+            slice = quantum;
+        if (slice > allotment - j->used)
+            slice = allotment - j->used;
+        if (slice > next_boost - now)
+            slice = next_boost - now;
+    }
+
+    cpu->idx = idx;
+    cpu->since = now;
+    cpu->until = now + (int)slice;
+    if (s->balance == SMP_GLOBAL) {
+        s->idle[c / 64] &= ~(1ULL << (c % 64));
+        heap_update(&s->ends, c, cpu->until);
+    }
+}
+
+// Mismo orden que el heap de STCF: (remaining, pid)
+static inline long long stcf_key(int remaining, int pid) {
+    return (long long)((unsigned long long)(long long)remaining << 32 |
+                       (unsigned)(pid ^ INT_MIN));
+}
+
+// STCF y MLFQ: un proceso que entra en la cola r expulsa al peor de los
+// que ejecutan sus CPUs si tiene más prioridad (menor (remaining, pid) o
+// menor nivel).  Con una CPU equivale a volver a elegir en cada llegada.
+static void preempt_check(smp_t *s, int r, int idx, int now) {
+    const proc_table_t *pt = s->pt;
+    int victim = -1;
+    long long worst = LLONG_MIN;
+
+    int lo = s->balance == SMP_GLOBAL ? 0 : r;
+    int hi = s->balance == SMP_GLOBAL ? s->num_cpus : r + 1;
+    for (int c = lo; c < hi; c++) {
+        int j = s->cpu[c].idx;
+        if (j < 0)
+            continue;
+        long long key = s->alg == SCHED_STCF
+            ? stcf_key(pt->remaining[j] - (now - s->cpu[c].since), pt->pid[j])
+            : s->job[j].level;
+        if (key > worst) {
+            worst = key;
+            victim = c;
+        }
+    }
+    if (victim < 0)
+        return;
+
+    long long key = s->alg == SCHED_STCF
+        ? stcf_key(pt->remaining[idx], pt->pid[idx])
+        : s->job[idx].level;
+    if (key < worst)
+        stop(s, victim, now);
+}
+
+// -----------------------------
+// Llegadas y balanceo
+// -----------------------------
+// Con colas por CPU la k-ésima llegada va a la CPU k % num_cpus
+static void arrive(smp_t *s, int r, int idx, int now) {
+    if (s->alg == SCHED_MLFQ) {
+        s->job[idx].level = 0;
+        s->job[idx].used = 0;
+        s->job[idx].epoch = s->rq[r].lv.epoch;
+    }
+    rq_push(s, r, idx);
+    if (s->alg == SCHED_STCF || s->alg == SCHED_MLFQ)
+        preempt_check(s, r, idx, now);
+}
+
+static void move(smp_t *s, int from, int to, int count) {
+    for (int k = 0; k < count; k++) {
+        int idx = rq_pop(s, from);
+        if (idx < 0)
+            break;
+        rq_push(s, to, idx);
+    }
+}
+
+// La CPU c se quedó sin trabajo: se lleva la mitad de la cola más larga
+// (los procesos que esa CPU iba a ejecutar primero)
+static void steal(smp_t *s, int c) {
+    int victim = -1, best = 0;
+    for (int r = 0; r < s->num_rqs; r++) {
+        int len = rq_len(s, r);
+        if (r != c && len > best) {
+            best = len;
+            victim = r;
+        }
+    }
+    if (victim >= 0)
+        move(s, victim, c, (best + 1) / 2);
+}
+
+// Empuja trabajo de la CPU más cargada (cola + proceso en ejecución) a la
+// menos cargada hasta que difieren en 1 como mucho
+static void push_balance(smp_t *s) {
+    for (;;) {
+        int busiest = 0, idlest = 0, max = -1, min = INT_MAX;
+        for (int c = 0; c < s->num_cpus; c++) {
+            int load = rq_len(s, c) + (s->cpu[c].idx >= 0);
+            if (load > max) { max = load; busiest = c; }
+            if (load < min) { min = load; idlest = c; }
+        }
+        if (max - min <= 1 || rq_len(s, busiest) == 0)
+            return;
+        move(s, busiest, idlest, 1);
+    }
+}
+
+// Una CPU libre cuya cola recibió trabajo toma el primero
+static void dispatch_cpu(smp_t *s, int c, int now) {
+    smp_cpu_t *cpu = &s->cpu[c];
+    if (cpu->idx < 0 && cpu->pending) {
+        int idx = rq_pop(s, cpu->rq);
+        if (idx >= 0)
+            start(s, c, idx, now);
+    }
+    cpu->pending = 0;
+}
+
+// Las CPUs libres toman trabajo de su cola, en orden de índice.  Con robo,
+// las que siguen libres roban después, para no quitarle a otra CPU libre
+// lo que acaba de llegar a su propia cola.
+static void dispatch(smp_t *s, int now) {
+    long long queued = 0;
+    for (int c = 0; c < s->num_cpus; c++) {
+        dispatch_cpu(s, c, now);
+        queued += rq_len(s, c);
+    }
+    for (int c = 0; c < s->num_cpus && s->balance == SMP_STEAL && queued > 0; c++) {
+        if (s->cpu[c].idx >= 0)
+            continue;
+        steal(s, c);
+        int idx = rq_pop(s, c);
+        if (idx >= 0) {
+            start(s, c, idx, now);
+            queued--;
+        }
+    }
+}
+
+// -----------------------------
+// SMP_GLOBAL: un único bucle de eventos
+// -----------------------------
+static void dispatch_global(smp_t *s, int now) {
+    for (int w = 0; w < s->words && rq_len(s, 0) > 0; w++) {
+        unsigned long long bits = s->idle[w];
+        while (bits && rq_len(s, 0) > 0) {
+            int c = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            start(s, c, rq_pop(s, 0), now);
+        }
+    }
+}
+
+static void run_global(smp_t *s) {
+    s->next_boost = next_tick(0, s->boost);
+    for (;;) {
+        int now = s->sim.time;
+
+        // 1. Tramos que terminan ahora (en orden de CPU)
+        int c;
+        while ((c = heap_peek(&s->ends)) >= 0 && s->cpu[c].until == now)
+            stop(s, c, now);
+
+        // 2. Llegadas; 3. los expulsados vuelven detrás de ellas
+        int i;
+        while ((i = sim_admit_next(&s->sim)) >= 0)
+            arrive(s, 0, i, now);
+        for (int k = 0; k < s->requeue_count; k++)
+            rq_push(s, s->requeue[k].rq, s->requeue[k].idx);
+        s->requeue_count = 0;
+
+        // 4. Boost de MLFQ; 5. despacho
+        if (now >= s->next_boost) {
+            rq_boost(s, 0, now);
+            s->next_boost = next_tick(now, s->boost);
+        }
+        dispatch_global(s, now);
+
+        // 6. Siguiente evento.  Sin nada en ejecución tampoco hay nada en
+        // cola: se salta a la siguiente llegada sin boosts intermedios.  A
+        // diferencia de una CPU no hay procesos bloqueados en E/S (smp_run
+        // no las admite) cuyo nivel dependa de ellos, y rq_boost deriva
+        // epoch del instante
+        int first = heap_peek(&s->ends);
+        long long next = sim_next_arrival(&s->sim);
+        if (s->cpu[first].until != INT_MAX) {
+            if (s->cpu[first].until < next)
+                next = s->cpu[first].until;
+        } else if (next != INT_MAX) {
+            s->next_boost = next_tick(next, s->boost);
+        }
+        if (next == INT_MAX || s->cpu[0].failed)
+            break;
+        s->sim.time = (int)next;
+    }
+}
+
+// -----------------------------
+// push/steal: ventanas
+// -----------------------------
+// Entre dos sincronizaciones ninguna CPU roba ni recibe trabajo empujado,
+// así que cada una simula sus propios eventos sin mirar a las demás.  En el
+// instante de sincronización cada CPU llega hasta antes del despacho y el
+// coordinador hace el resto en el mismo orden que el bucle único: boost de
+// las CPUs libres, balanceo y despacho con robo.
+static int arrival_at(const smp_t *s, int p) {
+    if (p >= s->pt->n)
+        return INT_MAX;
+    return s->pt->arrival[s->sim.order ? s->sim.order[p] : p];
+}
+
+static inline int cpu_next_event(const smp_t *s, const smp_cpu_t *cpu) {
+    int a = arrival_at(s, cpu->cursor);
+    return cpu->until < a ? cpu->until : a;
+}
+
+// Un instante de la CPU c; con partial se detiene antes del despacho
+static void cpu_step(smp_t *s, int c, int now, int partial) {
+    smp_cpu_t *cpu = &s->cpu[c];
+    if (cpu->until == now)
+        stop(s, c, now);
+    while (arrival_at(s, cpu->cursor) <= now) {
+        int p = cpu->cursor;
+        cpu->cursor += s->num_cpus;
+        arrive(s, c, s->sim.order ? s->sim.order[p] : p, now);
+    }
+    if (cpu->requeue >= 0) {
+        rq_push(s, c, cpu->requeue);
+        cpu->requeue = -1;
+    }
+    if (now >= cpu->next_boost) {
+        rq_boost(s, c, now);
+        cpu->next_boost = next_tick(now, s->boost);
+    }
+    if (!partial)
+        dispatch_cpu(s, c, now);
+}
+
+// Simula la CPU c hasta el instante horizon (éste sin despacho)
+static void cpu_advance(smp_t *s, int c, int horizon) {
+    for (;;) {
+        int t = cpu_next_event(s, &s->cpu[c]);
+        if (t == INT_MAX || t > horizon)
+            return;
+        cpu_step(s, c, t, t == horizon);
+        if (t == horizon)
+            return;
+    }
+}
+
+// CPU que antes se queda sin trabajo
+static int first_finish(const smp_t *s) {
+    int best = 0;
+    for (int c = 1; c < s->num_cpus; c++)
+        if (s->finish_at[c] < s->finish_at[best])
+            best = c;
+    return best;
+}
+
+// Primer instante posterior a now en que puede haber un robo: una CPU
+// libre mientras otra tiene procesos en cola.  Sin robos, una CPU con
+// trabajo siempre ejecuta, así que el instante en que se vacía no depende
+// de la política y se sigue llegada a llegada.
+static int steal_horizon(smp_t *s, int now) {
+    const proc_table_t *pt = s->pt;
+    int P = s->num_cpus, victims = 0, p = INT_MAX;
+    for (int c = 0; c < P; c++) {
+        const smp_cpu_t *cpu = &s->cpu[c];
+        long long end = now + s->rq[c].work;
+        if (cpu->idx >= 0)
+            end += pt->remaining[cpu->idx] - (now - cpu->since);
+        s->finish_at[c] = end < INT_MAX ? (int)end : INT_MAX;
+        s->multi[c] = cpu->idx >= 0 && rq_len(s, c) > 0;
+        victims += s->multi[c];
+        if (cpu->cursor < p)
+            p = cpu->cursor;
+    }
+    int first = first_finish(s);
+
+    for (;; p++) {
+        int a = arrival_at(s, p);
+        // Con procesos en cola en alguna CPU, el robo llega en cuanto otra
+        // se vacía
+        if (victims > 0 && s->finish_at[first] <= a)
+            return s->finish_at[first];
+        if (a == INT_MAX)
+            return INT_MAX;
+
+        // Si la CPU destino sigue ocupada, el proceso espera en su cola
+        int d = p % P;
+        int burst = pt->burst[s->sim.order ? s->sim.order[p] : p];
+        int end = s->finish_at[d];
+        if (end > a) {
+            victims += !s->multi[d];
+            s->multi[d] = 1;
+            end = end > INT_MAX - burst ? INT_MAX : end + burst;
+        } else {
+            victims -= s->multi[d];
+            s->multi[d] = 0;
+            end = a > INT_MAX - burst ? INT_MAX : a + burst;
+        }
+        s->finish_at[d] = end;
+        if (d == first)
+            first = first_finish(s);
+        if (victims > 0 && s->finish_at[first] <= a)
+            return a;
+    }
+}
+
+// Fin de la ventana en el instante now (un solo hilo).  Devuelve el fin de
+// la siguiente, o INT_MAX si ya no queda nada que simular.
+static int sync_window(smp_t *s, int now) {
+    int P = s->num_cpus;
+
+    for (int c = 0; c < P; c++) {
+        if (now >= s->cpu[c].next_boost) {
+            rq_boost(s, c, now);
+            s->cpu[c].next_boost = next_tick(now, s->boost);
+        }
+    }
+    if (now >= s->next_balance) {
+        push_balance(s);
+        s->next_balance = next_tick(now, s->interval);
+    }
+    dispatch(s, now);
+
+    // Eventos de la ventana, por CPU.  La siguiente ventana se acorta o
+    // alarga para que los búferes no crezcan sin límite.
+    int most = 0;
+    for (int c = 0; c < P && s->sink; c++) {
+        timeline_t *buf = &s->cpu[c].buf;
+        for (int k = 0; k < buf->count; k++)
+            s->sink->on_event(s->sink->ctx, &buf->events[k]);
+        if (buf->count > most)
+            most = buf->count;
+        timeline_clear(buf);
+    }
+    if (most > 4096 && s->window > 1)
+        s->window /= 2;
+    else if (most < 1024 && s->window < INT_MAX / 4)
+        s->window *= 2;
+
+    int first = INT_MAX, running = 0, failed = 0;
+    for (int c = 0; c < P; c++) {
+        int t = cpu_next_event(s, &s->cpu[c]);
+        if (t < first)
+            first = t;
+        running |= s->cpu[c].idx >= 0;
+        failed |= s->cpu[c].failed;
+    }
+    if (first == INT_MAX || failed)
+        return INT_MAX;
+
+    // Sin nada en ejecución se salta a la siguiente llegada, sin balanceos
+    // intermedios
+    if (!running)
+        s->next_balance = next_tick(first, s->interval);
+    long long horizon = s->balance == SMP_PUSH ? s->next_balance : steal_horizon(s, now);
+    if (horizon > (long long)first + s->window)
+        horizon = (long long)first + s->window;
+    return horizon < INT_MAX ? (int)horizon : INT_MAX - 1;
+}
+
+// Cada hilo avanza un tramo contiguo de CPUs; el 0 además sincroniza
+static void run_windows(void *ctx, int worker, int num_workers) {
+    smp_t *s = ctx;
+    int lo = (int)((long long)s->num_cpus * worker / num_workers);
+    int hi = (int)((long long)s->num_cpus * (worker + 1) / num_workers);
+    int sense = 0;
+    if (num_workers != s->barrier.threads)
+        pool_barrier_init(&s->barrier, num_workers);    // Sólo el llamante
+    for (;;) {
+        int horizon = s->horizon;
+        for (int c = lo; c < hi; c++)
+            cpu_advance(s, c, horizon);
+        pool_barrier_wait(&s->barrier, &sense);
+        if (worker == 0)
+            s->finished = (s->horizon = sync_window(s, horizon)) == INT_MAX;
+        pool_barrier_wait(&s->barrier, &sense);
+        if (s->finished)
+            return;
+    }
+}
+
+static void run_per_cpu(smp_t *s, int threads) {
+    int first = arrival_at(s, 0);
+    if (first == INT_MAX)
+        return;
+    s->window = s->sink ? 1024 : INT_MAX / 4;
+    s->next_balance = next_tick(first, s->interval);
+    long long horizon = s->balance == SMP_PUSH ? s->next_balance : steal_horizon(s, first - 1);
+    if (horizon > (long long)first + s->window)
+        horizon = (long long)first + s->window;
+    s->horizon = horizon < INT_MAX ? (int)horizon : INT_MAX - 1;
+    if (threads > s->num_cpus)
+        threads = s->num_cpus;
+    pool_barrier_init(&s->barrier, threads);
+    pool_spawn(threads, run_windows, s);
+}
+
+// -----------------------------
+// Reserva y liberación
+// -----------------------------
+static void sink_buffered(void *ctx, const timeline_event_t *ev) {
+    smp_cpu_t *cpu = ctx;
+    if (timeline_append_event(&cpu->buf, ev) != 0)
+        cpu->failed = 1;
+}
+
+static int smp_alloc(smp_t *s) {
+    int n = s->pt->n, P = s->num_cpus;
+    s->words = (P + 63) / 64;
+    s->cpu = calloc(P, sizeof(smp_cpu_t));
+    s->rq = calloc(s->num_rqs, sizeof(smp_rq_t));
+    s->last_cpu = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (s->alg == SCHED_SJF || s->alg == SCHED_STCF)
+        s->pos = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (s->alg == SCHED_MLFQ)
+        s->job = malloc((n > 0 ? n : 1) * sizeof(mlfq_job_t));
+    if (!s->cpu || !s->rq || !s->last_cpu ||
+        ((s->alg == SCHED_SJF || s->alg == SCHED_STCF) && !s->pos) ||
+        (s->alg == SCHED_MLFQ && !s->job))
+        return -1;
+    if (s->balance == SMP_GLOBAL) {
+        s->requeue = malloc(P * sizeof(smp_requeue_t));
+        s->idle = calloc(s->words, sizeof(unsigned long long));
+        if (!s->requeue || !s->idle || heap_init(&s->ends, P) != 0)
+            return -1;
+    } else {
+        s->finish_at = malloc(P * sizeof(int));
+        s->multi = malloc(P);
+        if (!s->finish_at || !s->multi)
+            return -1;
+    }
+
+    for (int i = 0; i < n; i++)
+        s->last_cpu[i] = -1;
+    if (s->pos)
+        for (int i = 0; i < n; i++)
+            s->pos[i] = -1;
+    for (int r = 0; r < s->num_rqs; r++)
+        if (rq_init(s, &s->rq[r]) != 0)
+            return -1;
+    for (int c = 0; c < P; c++) {
+        smp_cpu_t *cpu = &s->cpu[c];
+        cpu->rq = s->balance == SMP_GLOBAL ? 0 : c;
+        cpu->cursor = c;
+        cpu->requeue = -1;
+        cpu->last = -1;
+        cpu->next_boost = next_tick(0, s->boost);
+        if (s->balance == SMP_GLOBAL) {
+            stream_begin_cpu(&cpu->out, s->sink, c);
+            heap_push(&s->ends, c, INT_MAX, c);
+        } else {
+            // Los eventos esperan en la CPU hasta la sincronización: el
+            // sink sólo se llama desde el coordinador y en un orden fijo
+            if (s->sink && timeline_init(&cpu->buf, 64) != 0)
+                return -1;
+            cpu->buf_sink.on_event = sink_buffered;
+            cpu->buf_sink.flush = NULL;
+            cpu->buf_sink.ctx = cpu;
+            stream_begin_cpu(&cpu->out, s->sink ? &cpu->buf_sink : NULL, c);
+        }
+        set_idle(s, c);
+    }
+    return 0;
+}
+
+// -1 si el sink perdió algún evento
+static int smp_release(smp_t *s) {
+    int rc = 0;
+    if (s->cpu) {
+        // Lo pendiente de cada CPU, en orden, y un único flush al final
+        for (int c = 0; c < s->num_cpus; c++) {
+            smp_cpu_t *cpu = &s->cpu[c];
+            stream_drain(&cpu->out);
+            for (int k = 0; k < cpu->buf.count; k++)
+                s->sink->on_event(s->sink->ctx, &cpu->buf.events[k]);
+            timeline_free(&cpu->buf);
+        }
+        if (s->sink && s->sink->flush)
+            rc = s->sink->flush(s->sink->ctx);
+    }
+    if (s->rq)
+        for (int r = 0; r < s->num_rqs; r++)
+            rq_free(s, &s->rq[r]);
+    heap_free(&s->ends);
+    free(s->cpu);
+    free(s->rq);
+    free(s->last_cpu);
+    free(s->requeue);
+    free(s->idle);
+    free(s->finish_at);
+    free(s->multi);
+    free(s->pos);
+    free(s->job);
+    return rc;
+}
+
+int smp_run(sched_alg_t alg, proc_table_t *pt, int quantum, mlfq_config_t *config,
+            const smp_config_t *cfg, const timeline_sink_t *sink, smp_stats_t *stats) {
+    int P = cfg->num_cpus > 0 ? cfg->num_cpus : 1;
+    memset(stats, 0, sizeof(*stats));
+    stats->num_cpus = P;
+    if (pt->first)
+        return -1;
+    stats->busy = calloc(P, sizeof(long long));
+    if (!stats->busy)
+        return -1;
+
+    smp_t s;
+    memset(&s, 0, sizeof(s));
+    s.alg = alg;
+    s.pt = pt;
+    s.quantum = quantum > 0 ? quantum : 1;
+    s.config = config;
+    s.balance = cfg->balance;
+    s.num_cpus = P;
+    s.num_rqs = cfg->balance == SMP_GLOBAL ? 1 : P;
+    s.boost = alg == SCHED_MLFQ && config->boost_interval > 0 ? config->boost_interval : 0;
+    s.interval = cfg->balance == SMP_PUSH ? cfg->balance_interval : 0;
+    s.sink = sink;
+
+    if (sim_init(&s.sim, pt, NULL, NULL) != 0) {
+        smp_stats_free(stats);
+        return -1;
+    }
+    int failed = smp_alloc(&s) != 0;
+    if (!failed && s.balance == SMP_GLOBAL)
+        run_global(&s);
+    else if (!failed)
+        run_per_cpu(&s, cfg->threads > 0 ? cfg->threads : pool_default_threads());
+
+    int completed = 0;
+    for (int c = 0; c < P && s.cpu; c++) {
+        stats->busy[c] = s.cpu[c].busy;
+        stats->migrations += s.cpu[c].migrations;
+        stats->switches += s.cpu[c].switches;
+        completed += s.cpu[c].done;
+        failed |= s.cpu[c].failed;
+    }
+    failed |= completed < pt->n;
+    failed |= smp_release(&s) != 0;
+    sim_free(&s.sim);
+    stats->makespan = proc_table_makespan(pt);
+    if (failed) {
+        smp_stats_free(stats);
+        return -1;
+    }
+    return 0;
+}
+
+void smp_stats_free(smp_stats_t *stats) {
+    free(stats->busy);
+    stats->busy = NULL;
+}
+
+double smp_cpu_utilization(const smp_stats_t *stats, int cpu) {
+    return stats->makespan > 0 ? 100.0 * stats->busy[cpu] / stats->makespan : 0.0;
+}
+
+void smp_metrics(const proc_table_t *pt, const smp_stats_t *stats,
+                 metrics_t *metrics) {
+    calculate_metrics_table_cpus(pt, stats->makespan, stats->num_cpus, metrics);
+    metrics->migrations = stats->migrations;
+    metrics->context_switches = stats->switches;
+}
@@ -0,0 +1,85 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include "spsc.h"
+
+int spsc_init(spsc_t *q, size_t elem, size_t capacity) {
+    size_t cap = 1;
+    while (cap < capacity)
+        cap *= 2;
+    q->head = 0;
+    q->tail = 0;
+    q->elem = elem;
+    q->mask = cap - 1;
+    q->buf = malloc(cap * elem);
+    return q->buf ? 0 : -1;
+}
+
+void spsc_free(spsc_t *q) {
+    free(q->buf);
+    q->buf = NULL;
+}
+
+// Copia count elementos desde/hacia la posición pos del anillo, en dos
+// trozos si da la vuelta
+static void ring_copy(spsc_t *q, size_t pos, void *items, size_t count, int into_ring) {
+    size_t at = pos & q->mask;
+    size_t first = q->mask + 1 - at;
+    if (first > count)
+        first = count;
+    unsigned char *ring = q->buf + at * q->elem;
+    unsigned char *mem = items;
+    if (into_ring) {
+        memcpy(ring, mem, first * q->elem);
+        memcpy(q->buf, mem + first * q->elem, (count - first) * q->elem);
+    } else {
+        memcpy(mem, ring, first * q->elem);
+        memcpy(mem + first * q->elem, q->buf, (count - first) * q->elem);
+    }
+}
+
+size_t spsc_push(spsc_t *q, const void *items, size_t count) {
+    size_t tail = q->tail;
+    size_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    size_t room = q->mask + 1 - (tail - head);
+    if (count > room)
+        count = room;
+    if (count == 0)
+        return 0;
+    ring_copy(q, tail, (void *)items, count, 1);
+    __atomic_store_n(&q->tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+size_t spsc_push_wait(spsc_t *q, const void *items, size_t count, const int *stop) {
+    const unsigned char *mem = items;
+    size_t done = 0;
+    for (int spins = 0; done < count; spins++) {
+        size_t k = spsc_push(q, mem + done * q->elem, count - done);
+        done += k;
+        if (k > 0)
+            spins = 0;
+        else if (__atomic_load_n(stop, __ATOMIC_ACQUIRE))
+            break;
+        else if (spins > 1000)
+            nanosleep(&(struct timespec){ 0, 1000000 }, NULL);     // 1 ms
+        else if (spins > 100)
+            sched_yield();
+    }
+    return done;
+}
+
+size_t spsc_pop(spsc_t *q, void *items, size_t max) {
+    size_t head = q->head;
+    size_t tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    size_t count = tail - head;
+    if (count > max)
+        count = max;
+    if (count == 0)
+        return 0;
+    ring_copy(q, head, items, count, 0);
+    __atomic_store_n(&q->head, head + count, __ATOMIC_RELEASE);
+    return count;
+}
@@ -0,0 +1,259 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include "sweep.h"
+#include "pool.h"
+
+// -----------------------------
+// Especificación
+// -----------------------------
+void sweep_spec_default(sweep_spec_t *spec) {
+    spec->quantum = (sweep_range_t){ 1, 10, 1 };
+    spec->levels = (sweep_range_t){ 2, 4, 1 };
+    spec->base = (sweep_range_t){ 1, 4, 1 };
+    spec->growth = (sweep_range_t){ 2, 2, 1 };
+    spec->boost = (sweep_range_t){ 0, 200, 50 };
+    spec->cost = (switch_cost_t){ 0, 0, 0 };
+}
+
+// "lo:hi[:step]" o "v"
+static int parse_range(const char *v, sweep_range_t *r) {
+    long x[3] = { 0, 0, 1 };
+    int k = 0;
+    const char *c = v;
+    for (;;) {
+        char *end;
+        x[k] = strtol(c, &end, 10);
+        if (end == c || x[k] < 0 || x[k] > INT_MAX)
+            return -1;
+        k++;
+        if (*end == '\0')
+            break;
+        if (*end != ':' || k == 3)
+            return -1;
+        c = end + 1;
+    }
+    if (k == 1)
+        x[1] = x[0];
+    if (x[1] < x[0] || x[2] < 1)
+        return -1;
+    r->lo = (int)x[0];
+    r->hi = (int)x[1];
+    r->step = (int)x[2];
+    return 0;
+}
+
+int sweep_spec_parse(sweep_spec_t *spec, const char *text, char *err, size_t errlen) {
+    char *copy = strdup(text);
+    if (!copy) {
+        snprintf(err, errlen, "out of memory");
+        return -1;
+    }
+
+    int rc = 0;
+    char *save;
+    for (char *tok = strtok_r(copy, ",", &save); tok;
+         tok = strtok_r(NULL, ",", &save)) {
+        char *eq = strchr(tok, '=');
+        if (!eq) {
+            snprintf(err, errlen, "'%s': expected key=lo:hi[:step]", tok);
+            rc = -1;
+            break;
+        }
+        *eq = '\0';
+        const char *key = tok, *val = eq + 1;
+        sweep_range_t r;
+        sweep_range_t *dst = NULL;
+        int min = 1;
+
+        if (strcmp(key, "q") == 0) { dst = &spec->quantum; min = 0; }
+        else if (strcmp(key, "levels") == 0) { dst = &spec->levels; min = 0; }
+        else if (strcmp(key, "base") == 0) dst = &spec->base;
+        else if (strcmp(key, "growth") == 0) dst = &spec->growth;
+        else if (strcmp(key, "boost") == 0) { dst = &spec->boost; min = 0; }
+
+        if (!dst || parse_range(val, &r) != 0 || r.lo < min ||
+            (dst == &spec->levels && r.hi > SWEEP_MAX_LEVELS) ||
+            (min == 0 && dst != &spec->boost && r.lo == 0 && r.hi != 0)) {
+            snprintf(err, errlen, "invalid sweep spec entry '%s=%s'", key, val);
+            rc = -1;
+            break;
+        }
+        *dst = r;
+    }
+    free(copy);
+    return rc;
+}
+
+static int range_count(const sweep_range_t *r) {
+    return (r->hi - r->lo) / r->step + 1;
+}
+
+int sweep_count(const sweep_spec_t *spec) {
+    long long rr = spec->quantum.hi > 0 ? range_count(&spec->quantum) : 0;
+    long long mlfq = spec->levels.hi > 0
+        ? (long long)range_count(&spec->levels) * range_count(&spec->base) *
+          range_count(&spec->growth) * range_count(&spec->boost)
+        : 0;
+    return rr + mlfq > INT_MAX ? -1 : (int)(rr + mlfq);
+}
+
+// Rellena results con las configuraciones, en orden RR y luego MLFQ
+static void sweep_configs(const sweep_spec_t *spec, sweep_result_t *results) {
+    int k = 0;
+    if (spec->quantum.hi > 0)
+        for (int q = spec->quantum.lo; q <= spec->quantum.hi; q += spec->quantum.step) {
+            memset(&results[k], 0, sizeof(results[k]));
+            results[k].alg = SCHED_RR;
+            results[k++].quantum = q;
+            if (q > INT_MAX - spec->quantum.step) break;
+        }
+    if (spec->levels.hi == 0)
+        return;
+
+    const sweep_range_t *L = &spec->levels, *B = &spec->base,
+                        *G = &spec->growth, *T = &spec->boost;
+    for (int levels = L->lo; levels <= L->hi; levels += L->step)
+        for (long long base = B->lo; base <= B->hi; base += B->step)
+            for (long long g = G->lo; g <= G->hi; g += G->step)
+                for (long long boost = T->lo; boost <= T->hi; boost += T->step) {
+                    sweep_result_t *r = &results[k++];
+                    memset(r, 0, sizeof(*r));
+                    r->alg = SCHED_MLFQ;
+                    r->num_queues = levels;
+                    r->boost_interval = (int)boost;
+                    long long q = base;
+                    for (int i = 0; i < levels; i++) {
+                        r->quantums[i] = (int)q;
+                        q = q * g > INT_MAX ? INT_MAX : q * g;
+                    }
+                }
+}
+
+// -----------------------------
+// Ejecución
+// -----------------------------
+typedef struct {
+    sweep_result_t *results;
+    proc_table_t *tables;       // Una tabla de trabajo por hilo
+    const switch_cost_t *cost;
+    int failed;                 // Alguna simulación se quedó sin memoria
+} sweep_job_t;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void sweep_task(void *ctx, int task, int worker) {
+    sweep_job_t *job = ctx;
+    sweep_result_t *r = &job->results[task];
+    proc_table_t *pt = &job->tables[worker];
+
+    mlfq_config_t config = { r->num_queues, r->quantums, r->boost_interval, NULL };
+    double t0 = now_seconds();
+    switch_stats_t switches;
+    if (schedule_run_table_cost(r->alg, pt, r->quantum, &config, job->cost, NULL,
+                                &switches) != 0) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    r->sim_seconds = now_seconds() - t0;
+
+    r->makespan = proc_table_makespan(pt);
+    calculate_metrics_table(pt, r->makespan, &r->metrics);
+    metrics_add_switches(&r->metrics, &switches, r->makespan);
+}
+
+int sweep_run(const sweep_spec_t *spec, const proc_table_t *pt,
+              int num_threads, sweep_result_t *results) {
+    int count = sweep_count(spec);
+    if (count <= 0)
+        return count < 0 ? -1 : 0;
+    sweep_configs(spec, results);
+
+    if (num_threads <= 0)
+        num_threads = pool_default_threads();
+    if (num_threads > count)
+        num_threads = count;
+
+    sweep_job_t job = { results, calloc(num_threads, sizeof(proc_table_t)), &spec->cost, 0 };
+    int rc = job.tables ? 0 : -1;
+    for (int i = 0; i < num_threads && rc == 0; i++)
+        rc = proc_table_init_shared(&job.tables[i], pt);
+
+    if (rc == 0)
+        rc = pool_run(count, num_threads, sweep_task, &job);
+    if (rc == 0 && job.failed)
+        rc = -1;
+    if (rc == 0)
+        sweep_pareto(results, count);
+
+    if (job.tables)
+        for (int i = 0; i < num_threads; i++)
+            proc_table_free(&job.tables[i]);
+    free(job.tables);
+    return rc;
+}
+
+// -----------------------------
+// Frente de Pareto
+// -----------------------------
+typedef struct {
+    double turnaround;
+    int p99;
+    int idx;
+} pareto_point_t;
+
+static int by_objectives(const void *a, const void *b) {
+    const pareto_point_t *x = a, *y = b;
+    if (x->turnaround != y->turnaround)
+        return x->turnaround < y->turnaround ? -1 : 1;
+    return (x->p99 > y->p99) - (x->p99 < y->p99);
+}
+
+int sweep_pareto(sweep_result_t *results, int count) {
+    pareto_point_t *pts = malloc((count > 0 ? count : 1) * sizeof(pareto_point_t));
+    if (!pts)
+        return -1;
+    for (int i = 0; i < count; i++) {
+        pts[i].turnaround = results[i].metrics.avg_turnaround_time;
+        pts[i].p99 = results[i].metrics.response.p99;
+        pts[i].idx = i;
+        results[i].pareto = 0;
+    }
+    qsort(pts, count, sizeof(pareto_point_t), by_objectives);
+
+    // Ordenadas por turnaround, una configuración está en el frente si
+    // mejora el p99 de todas las anteriores (o empata en ambos objetivos
+    // con el último punto del frente)
+    int front = 0;
+    const pareto_point_t *last = NULL;
+    for (int k = 0; k < count; k++) {
+        const pareto_point_t *p = &pts[k];
+        if (!last || p->p99 < last->p99 ||
+            (p->p99 == last->p99 && p->turnaround == last->turnaround)) {
+            results[p->idx].pareto = 1;
+            last = p;
+            front++;
+        }
+    }
+    free(pts);
+    return front;
+}
+
+void sweep_label(const sweep_result_t *r, char *buf, size_t len) {
+    if (r->alg == SCHED_RR) {
+        snprintf(buf, len, "RR q=%d", r->quantum);
+        return;
+    }
+    int off = snprintf(buf, len, "MLFQ ");
+    for (int i = 0; i < r->num_queues && off < (int)len; i++)
+        off += snprintf(buf + off, len - off, i ? ":%d" : "%d", r->quantums[i]);
+    if (off < (int)len)
+        snprintf(buf + off, len - off, " boost=%d", r->boost_interval);
+}
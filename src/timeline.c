@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include "timeline.h"
+
+int timeline_init(timeline_t *tl, int capacity) {
+    if (capacity < 1)
+        capacity = 1;
+    tl->count = 0;
+    tl->capacity = capacity;
+    tl->failed = 0;
+    tl->events = malloc(capacity * sizeof(timeline_event_t));
+    return tl->events ? 0 : -1;
+}
+
+void timeline_free(timeline_t *tl) {
+    free(tl->events);
+    tl->events = NULL;
+    tl->count = 0;
+    tl->capacity = 0;
+    tl->failed = 0;
+}
+
+void timeline_clear(timeline_t *tl) {
+    tl->count = 0;
+    tl->failed = 0;
+}
+
+void timeline_truncate(timeline_t *tl, int time) {
+    int lo = 0, hi = tl->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (tl->events[mid].time < time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    tl->count = lo;
+    if (lo > 0) {
+        timeline_event_t *last = &tl->events[lo - 1];
+        if (last->time + last->duration > time)
+            last->duration = time - last->time;
+    }
+}
+
+int timeline_append(timeline_t *tl, int time, int pid, int duration) {
+    timeline_event_t ev = { time, pid, duration, 0 };
+    return timeline_append_event(tl, &ev);
+}
+
+int timeline_append_event(timeline_t *tl, const timeline_event_t *ev) {
+    if (ev->duration <= 0)
+        return 0;
+
+    if (tl->count > 0) {
+        timeline_event_t *last = &tl->events[tl->count - 1];
+        if (last->pid == ev->pid && last->cpu == ev->cpu &&
+            last->time + last->duration == ev->time) {
+            last->duration += ev->duration;
+            return 0;
+        }
+    }
+
+    if (tl->count == tl->capacity) {
+        int capacity = tl->capacity > 0 ? tl->capacity * 2 : 64;
+        timeline_event_t *events = realloc(tl->events,
+                                           capacity * sizeof(timeline_event_t));
+        if (!events)
+            return -1;
+        tl->events = events;
+        tl->capacity = capacity;
+    }
+
+    tl->events[tl->count++] = *ev;
+    return 0;
+}
+
+static void timeline_sink_event(void *ctx, const timeline_event_t *ev) {
+    timeline_t *tl = ctx;
+    if (timeline_append_event(tl, ev) != 0)
+        tl->failed = 1;
+}
+
+static int timeline_sink_flush(void *ctx) {
+    const timeline_t *tl = ctx;
+    return tl->failed ? -1 : 0;
+}
+
+timeline_sink_t timeline_as_sink(timeline_t *tl) {
+    timeline_sink_t sink = { timeline_sink_event, timeline_sink_flush, tl };
+    return sink;
+}
+
+void stream_begin(timeline_stream_t *st, const timeline_sink_t *sink) {
+    stream_begin_cpu(st, sink, 0);
+}
+
+void stream_begin_cpu(timeline_stream_t *st, const timeline_sink_t *sink, int cpu) {
+    st->sink = sink;
+    st->has_pending = 0;
+    st->cpu = cpu;
+}
+
+void stream_slice(timeline_stream_t *st, int time, int pid, int duration) {
+    if (!st->sink || duration <= 0)
+        return;
+
+    timeline_event_t *ev = &st->pending;
+    if (st->has_pending) {
+        if (ev->pid == pid && ev->time + ev->duration == time) {
+            ev->duration += duration;
+            return;
+        }
+        st->sink->on_event(st->sink->ctx, ev);
+    }
+    ev->time = time;
+    ev->pid = pid;
+    ev->duration = duration;
+    ev->cpu = st->cpu;
+    st->has_pending = 1;
+}
+
+int stream_end(timeline_stream_t *st) {
+    stream_drain(st);
+    if (st->sink && st->sink->flush)
+        return st->sink->flush(st->sink->ctx);
+    return 0;
+}
+
+void stream_drain(timeline_stream_t *st) {
+    if (!st->sink)
+        return;
+    if (st->has_pending)
+        st->sink->on_event(st->sink->ctx, &st->pending);
+    st->has_pending = 0;
+}
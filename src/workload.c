@@ -0,0 +1,754 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "workload.h"
+
+static int fail(char *err, size_t errlen, const char *fmt, ...) {
+    if (err && errlen > 0) {
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(err, errlen, fmt, ap);
+        va_end(ap);
+    }
+    return -1;
+}
+
+static int host_little_endian(void) {
+    const uint16_t one = 1;
+    return *(const uint8_t *)&one == 1;
+}
+
+static uint32_t load_le32(const void *src) {
+    const uint8_t *b = src;
+    return (uint32_t)b[0] | (uint32_t)b[1] << 8 |
+           (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+static uint64_t load_le64(const void *src) {
+    const uint8_t *b = src;
+    return (uint64_t)load_le32(b) | (uint64_t)load_le32(b + 4) << 32;
+}
+
+static void store_le32(void *dst, uint32_t v) {
+    uint8_t *b = dst;
+    b[0] = v; b[1] = v >> 8; b[2] = v >> 16; b[3] = v >> 24;
+}
+
+static void store_le64(void *dst, uint64_t v) {
+    store_le32(dst, (uint32_t)v);
+    store_le32((uint8_t *)dst + 4, (uint32_t)(v >> 32));
+}
+
+/* Map a whole file read-only; an empty file maps to (NULL, 0) */
+static int map_file(const char *filename, void **data, size_t *size,
+                    char *err, size_t errlen) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return fail(err, errlen, "%s: %s", filename, strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return fail(err, errlen, "%s: %s", filename, strerror(errno));
+    }
+    *size = (size_t)st.st_size;
+    *data = NULL;
+    if (*size > 0) {
+        *data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (*data == MAP_FAILED) {
+            close(fd);
+            return fail(err, errlen, "%s: mmap: %s", filename, strerror(errno));
+        }
+        madvise(*data, *size, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    return 0;
+}
+
+void workload_init(workload_t *wl) {
+    wl->processes = NULL;
+    wl->n = 0;
+    wl->capacity = 0;
+    wl->bursts = NULL;
+    wl->num_bursts = 0;
+    wl->bursts_capacity = 0;
+}
+
+void workload_free(workload_t *wl) {
+    free(wl->processes);
+    free(wl->bursts);
+    workload_init(wl);
+}
+
+static int workload_reserve(workload_t *wl, size_t capacity) {
+    if (capacity <= (size_t)wl->capacity)
+        return 0;
+    if (capacity > INT_MAX)
+        return -1;
+    process_t *p = realloc(wl->processes, capacity * sizeof(process_t));
+    if (!p)
+        return -1;
+    wl->processes = p;
+    wl->capacity = (int)capacity;
+    return 0;
+}
+
+int workload_add(workload_t *wl, int pid, int arrival, int burst, int priority) {
+    if (wl->n == wl->capacity &&
+        workload_reserve(wl, wl->capacity > 0 ? (size_t)wl->capacity * 2 : 1024) != 0)
+        return -1;
+    process_t *p = &wl->processes[wl->n++];
+    memset(p, 0, sizeof(*p));
+    p->pid = pid;
+    p->arrival_time = arrival;
+    p->burst_time = burst;
+    p->priority = priority;
+    p->remaining_time = burst;
+    return 0;
+}
+
+// Los process_t.bursts apuntan dentro de wl->bursts, en el orden de los
+// procesos: si el arreglo se mueve basta con volver a recorrerlo
+static void link_bursts(workload_t *wl) {
+    size_t off = 0;
+    for (int i = 0; i < wl->n; i++) {
+        process_t *p = &wl->processes[i];
+        if (p->num_bursts > 1) {
+            p->bursts = wl->bursts + off;
+            off += p->num_bursts;
+        }
+    }
+}
+
+static int reserve_bursts(workload_t *wl, size_t capacity) {
+    if (capacity <= wl->bursts_capacity)
+        return 0;
+    size_t cap = wl->bursts_capacity > 0 ? wl->bursts_capacity : 1024;
+    while (cap < capacity)
+        cap *= 2;
+    int *b = realloc(wl->bursts, cap * sizeof(int));
+    if (!b)
+        return -1;
+    wl->bursts = b;
+    wl->bursts_capacity = cap;
+    link_bursts(wl);
+    return 0;
+}
+
+int workload_add_bursts(workload_t *wl, int pid, int arrival, int priority,
+                        const int *bursts, int num_bursts) {
+    if (num_bursts <= 1)
+        return workload_add(wl, pid, arrival, num_bursts == 1 ? bursts[0] : 0, priority);
+    if (reserve_bursts(wl, wl->num_bursts + num_bursts) != 0 ||
+        workload_add(wl, pid, arrival, 0, priority) != 0)
+        return -1;
+
+    process_t *p = &wl->processes[wl->n - 1];
+    int *dst = wl->bursts + wl->num_bursts;
+    memcpy(dst, bursts, num_bursts * sizeof(int));
+    wl->num_bursts += num_bursts;
+    for (int k = 0; k < num_bursts; k++) {
+        if (k % 2 == 0)
+            p->burst_time += bursts[k];
+        else
+            p->io_time += bursts[k];
+    }
+    p->remaining_time = p->burst_time;
+    p->num_bursts = num_bursts;
+    p->bursts = dst;
+    return 0;
+}
+
+// -----------------------------
+// Texto: "pid arrival burst priority [io burst]..." por línea
+// -----------------------------
+// Suma las ráfagas de un proceso con E/S; -1 si alguna no es positiva o
+// el total de CPU o de E/S no cabe en un int
+static int check_bursts(const int *bursts, int num_bursts) {
+    long long total[2] = { 0, 0 };
+    for (int k = 0; k < num_bursts; k++) {
+        if (bursts[k] <= 0)
+            return -1;
+        total[k % 2] += bursts[k];
+    }
+    return total[0] > INT_MAX || total[1] > INT_MAX ? -1 : 0;
+}
+
+// El proceso debe poder terminar antes de INT_MAX aunque no espere nada:
+// los instantes son int y el motor usa INT_MAX como "no quedan llegadas"
+static int check_arrival(int arrival, const int *bursts, int num_bursts) {
+    long long end = arrival;
+    for (int k = 0; k < num_bursts; k++)
+        end += bursts[k];
+    return arrival < 0 || end > INT_MAX ? -1 : 0;
+}
+
+static int parse_text(const char *buf, size_t size, const char *filename,
+                      workload_t *wl, char *err, size_t errlen) {
+    const char *p = buf, *end = buf + size;
+
+    // Una línea por proceso como mucho: una sola reserva para todo el archivo
+    size_t lines = 1;
+    for (const char *c = buf; c < end && (c = memchr(c, '\n', end - c)); c++)
+        lines++;
+    if (workload_reserve(wl, wl->n + lines) != 0)
+        return fail(err, errlen, "%s: out of memory for %zu lines", filename, lines);
+
+    // Campos de la línea; sólo crece con líneas de muchas ráfagas
+    int small[16], *v = small, capacity = 16;
+    int rc = 0;
+    long lineno = 1;
+    while (p < end && rc == 0) {
+        int fields = 0;
+        for (;;) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+                p++;
+            if (p == end || *p == '\n' || *p == '#')
+                break;
+            if (fields == capacity) {
+                int *grown = malloc(2 * capacity * sizeof(int));
+                if (!grown) {
+                    rc = fail(err, errlen, "%s:%ld: out of memory", filename, lineno);
+                    break;
+                }
+                memcpy(grown, v, capacity * sizeof(int));
+                if (v != small)
+                    free(v);
+                v = grown;
+                capacity *= 2;
+            }
+
+            int neg = 0;
+            if (*p == '-' || *p == '+') {
+                neg = (*p == '-');
+                p++;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                rc = fail(err, errlen, "%s:%ld: expected an integer", filename, lineno);
+                break;
+            }
+            long long x = 0;
+            while (p < end && *p >= '0' && *p <= '9' && x <= INT_MAX)
+                x = x * 10 + (*p++ - '0');
+            if (x > INT_MAX) {
+                rc = fail(err, errlen, "%s:%ld: integer out of range", filename, lineno);
+                break;
+            }
+            if (p < end && *p != ' ' && *p != '\t' && *p != '\r' &&
+                *p != '\n' && *p != '#') {
+                rc = fail(err, errlen, "%s:%ld: unexpected character '%c'",
+                          filename, lineno, *p);
+                break;
+            }
+            v[fields++] = (int)(neg ? -x : x);
+        }
+        if (rc != 0)
+            break;
+
+        if (fields == 4) {
+            if (v[2] <= 0) {
+                rc = fail(err, errlen, "%s:%ld: burst must be positive", filename, lineno);
+            } else if (check_arrival(v[1], v + 2, 1) != 0) {
+                rc = fail(err, errlen, "%s:%ld: arrival must be non-negative and the "
+                          "process must end by %d", filename, lineno, INT_MAX);
+            } else {
+                process_t *pr = &wl->processes[wl->n++];
+                memset(pr, 0, sizeof(*pr));
+                pr->pid = v[0];
+                pr->arrival_time = v[1];
+                pr->burst_time = v[2];
+                pr->priority = v[3];
+                pr->remaining_time = v[2];
+            }
+        } else if (fields > 4 && fields % 2 == 0) {
+            // Ráfagas: la de CPU del tercer campo y luego los pares io/cpu
+            int pid = v[0], arrival = v[1], priority = v[3];
+            v[3] = v[2];
+            if (check_bursts(v + 3, fields - 3) != 0)
+                rc = fail(err, errlen, "%s:%ld: bursts must be positive and add up "
+                          "to at most %d", filename, lineno, INT_MAX);
+            else if (check_arrival(arrival, v + 3, fields - 3) != 0)
+                rc = fail(err, errlen, "%s:%ld: arrival must be non-negative and the "
+                          "process must end by %d", filename, lineno, INT_MAX);
+            else if (workload_add_bursts(wl, pid, arrival, priority, v + 3, fields - 3) != 0)
+                rc = fail(err, errlen, "%s:%ld: out of memory", filename, lineno);
+        } else if (fields != 0) {
+            rc = fail(err, errlen,
+                      "%s:%ld: expected 'pid arrival burst priority [io burst]...', "
+                      "got %d field(s)", filename, lineno, fields);
+        }
+
+        // Resto de la línea (comentario) y salto
+        const char *nl = memchr(p, '\n', end - p);
+        p = nl ? nl + 1 : end;
+        lineno++;
+    }
+    if (v != small)
+        free(v);
+    return rc;
+}
+
+int workload_load_text(const char *filename, workload_t *wl, char *err, size_t errlen) {
+    void *data;
+    size_t size;
+    if (map_file(filename, &data, &size, err, errlen) != 0)
+        return -1;
+    int rc = parse_text(data, size, filename, wl, err, errlen);
+    if (data)
+        munmap(data, size);
+    return rc;
+}
+
+// -----------------------------
+// Binario
+// -----------------------------
+// Comprueba la cabecera; *bursts = ráfagas de la sección de E/S, o -1 si
+// el archivo es de la versión 1
+static int check_header(const void *data, size_t size, const char *filename,
+                        uint64_t *count, int64_t *bursts, char *err, size_t errlen) {
+    const uint8_t *h = data;
+    if (size < sizeof(workload_header_t) ||
+        memcmp(h, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC)) != 0)
+        return fail(err, errlen, "%s: not a binary workload", filename);
+
+    uint32_t version = load_le32(h + offsetof(workload_header_t, version));
+    uint32_t record_size = load_le32(h + offsetof(workload_header_t, record_size));
+    *count = load_le64(h + offsetof(workload_header_t, count));
+    if (version != WORKLOAD_VERSION && version != WORKLOAD_VERSION_IO)
+        return fail(err, errlen, "%s: unsupported version %u", filename, version);
+    if (record_size != sizeof(workload_record_t))
+        return fail(err, errlen, "%s: unexpected record size %u", filename, record_size);
+    size_t body = size - sizeof(workload_header_t);
+    if (*count > body / sizeof(workload_record_t) || *count > INT_MAX)
+        return fail(err, errlen, "%s: truncated (%llu records announced)",
+                    filename, (unsigned long long)*count);
+
+    *bursts = -1;
+    if (version == WORKLOAD_VERSION_IO) {
+        uint64_t total = load_le64(h + offsetof(workload_header_t, bursts));
+        size_t left = body - *count * sizeof(workload_record_t);
+        if (*count > left / sizeof(uint32_t) ||
+            total > (left - *count * sizeof(uint32_t)) / sizeof(int32_t))
+            return fail(err, errlen, "%s: truncated burst section", filename);
+        *bursts = (int64_t)total;
+    }
+    return 0;
+}
+
+// Cada registro cumple lo mismo que una línea de texto (check_bursts y
+// check_arrival); con E/S sus ráfagas de la sección deben ser un número
+// impar y repartirse exactamente entre los procesos.  Los errores indican
+// el índice del registro.
+static int check_records(const uint8_t *records, const uint8_t *counts,
+                         const uint8_t *bursts, uint64_t count, int64_t total,
+                         const char *filename, char *err, size_t errlen) {
+    uint64_t used = 0;
+    int one, *run = NULL;
+    uint32_t capacity = 0;
+    int rc = 0;
+    for (uint64_t i = 0; i < count; i++, records += sizeof(workload_record_t)) {
+        int arrival = (int32_t)load_le32(records + 4);
+        uint32_t c = total >= 0 ? load_le32(counts + 4 * i) : 0;
+        const int *b = &one;
+        if (c == 0) {
+            one = (int32_t)load_le32(records + 8);
+            c = 1;
+            if (one <= 0) {
+                rc = fail(err, errlen, "%s: record %llu: burst must be positive",
+                          filename, (unsigned long long)i);
+                break;
+            }
+        } else {
+            if (c % 2 == 0 || c > (uint64_t)total - used) {
+                rc = fail(err, errlen, "%s: record %llu: malformed burst section",
+                          filename, (unsigned long long)i);
+                break;
+            }
+            if (c > capacity) {
+                int *grown = realloc(run, c * sizeof(int));
+                if (!grown) {
+                    rc = fail(err, errlen, "%s: out of memory", filename);
+                    break;
+                }
+                run = grown;
+                capacity = c;
+            }
+            for (uint32_t k = 0; k < c; k++)
+                run[k] = (int32_t)load_le32(bursts + 4 * (used + k));
+            used += c;
+            b = run;
+            if (check_bursts(b, (int)c) != 0) {
+                rc = fail(err, errlen, "%s: record %llu: bursts must be positive and "
+                          "add up to at most %d", filename, (unsigned long long)i, INT_MAX);
+                break;
+            }
+        }
+        if (check_arrival(arrival, b, (int)c) != 0) {
+            rc = fail(err, errlen, "%s: record %llu: arrival must be non-negative and "
+                      "the process must end by %d", filename, (unsigned long long)i, INT_MAX);
+            break;
+        }
+    }
+    free(run);
+    if (rc == 0 && total >= 0 && used != (uint64_t)total)
+        rc = fail(err, errlen, "%s: malformed burst section", filename);
+    return rc;
+}
+
+int workload_map_binary(const char *filename, workload_view_t *view,
+                        char *err, size_t errlen) {
+    if (!host_little_endian())
+        return fail(err, errlen, "%s: zero-copy view needs a little-endian host",
+                    filename);
+
+    void *data;
+    size_t size;
+    uint64_t count;
+    int64_t bursts;
+    if (map_file(filename, &data, &size, err, errlen) != 0)
+        return -1;
+    if (check_header(data, size, filename, &count, &bursts, err, errlen) != 0) {
+        if (data)
+            munmap(data, size);
+        return -1;
+    }
+    view->map = data;
+    view->map_size = size;
+    view->count = (size_t)count;
+    view->records = (const workload_record_t *)
+        ((const uint8_t *)data + sizeof(workload_header_t));
+    view->burst_counts = NULL;
+    view->bursts = NULL;
+    view->num_bursts = 0;
+    const uint8_t *counts = (const uint8_t *)(view->records + count);
+    const uint8_t *section = counts + count * sizeof(uint32_t);
+    if (check_records((const uint8_t *)view->records, counts, section, count,
+                      bursts, filename, err, errlen) != 0) {
+        munmap(data, size);
+        return -1;
+    }
+    if (bursts >= 0) {
+        view->burst_counts = (const uint32_t *)counts;
+        view->bursts = (const int32_t *)section;
+        view->num_bursts = (size_t)bursts;
+    }
+    return 0;
+}
+
+void workload_unmap(workload_view_t *view) {
+    if (view->map)
+        munmap(view->map, view->map_size);
+    view->map = NULL;
+    view->records = NULL;
+    view->count = 0;
+    view->burst_counts = NULL;
+    view->bursts = NULL;
+    view->num_bursts = 0;
+}
+
+int workload_load_binary(const char *filename, workload_t *wl, char *err, size_t errlen) {
+    void *data;
+    size_t size;
+    uint64_t count;
+    int64_t total;
+    if (map_file(filename, &data, &size, err, errlen) != 0)
+        return -1;
+    if (check_header(data, size, filename, &count, &total, err, errlen) != 0) {
+        if (data)
+            munmap(data, size);
+        return -1;
+    }
+    const uint8_t *r = (const uint8_t *)data + sizeof(workload_header_t);
+    const uint8_t *counts = r + count * sizeof(workload_record_t);
+    const uint8_t *section = counts + count * sizeof(uint32_t);
+    if (check_records(r, counts, section, count, total, filename, err, errlen) != 0) {
+        munmap(data, size);
+        return -1;
+    }
+    if (workload_reserve(wl, wl->n + count) != 0 ||
+        (total > 0 && reserve_bursts(wl, wl->num_bursts + (size_t)total) != 0)) {
+        munmap(data, size);
+        return fail(err, errlen, "%s: out of memory for %llu processes",
+                    filename, (unsigned long long)count);
+    }
+
+    int bursts[64];
+    for (uint64_t i = 0; i < count; i++, r += sizeof(workload_record_t)) {
+        int pid = (int32_t)load_le32(r);
+        int arrival = (int32_t)load_le32(r + 4);
+        int priority = (int32_t)load_le32(r + 12);
+        uint32_t c = total > 0 ? load_le32(counts + 4 * i) : 0;
+        if (c == 0) {
+            process_t *p = &wl->processes[wl->n++];
+            memset(p, 0, sizeof(*p));
+            p->pid = pid;
+            p->arrival_time = arrival;
+            p->burst_time = (int32_t)load_le32(r + 8);
+            p->priority = priority;
+            p->remaining_time = p->burst_time;
+            continue;
+        }
+        // Reservado arriba: workload_add_bursts no puede fallar
+        int *b = c <= 64 ? bursts : malloc(c * sizeof(int));
+        if (!b) {
+            munmap(data, size);
+            return fail(err, errlen, "%s: out of memory", filename);
+        }
+        for (uint32_t k = 0; k < c; k++, section += 4)
+            b[k] = (int32_t)load_le32(section);
+        workload_add_bursts(wl, pid, arrival, priority, b, (int)c);
+        if (b != bursts)
+            free(b);
+    }
+    munmap(data, size);
+    return 0;
+}
+
+int workload_load(const char *filename, workload_t *wl, char *err, size_t errlen) {
+    FILE *f = fopen(filename, "rb");
+    if (!f)
+        return fail(err, errlen, "%s: %s", filename, strerror(errno));
+    char magic[sizeof(WORKLOAD_MAGIC)] = {0};
+    size_t got = fread(magic, 1, sizeof(magic), f);
+    fclose(f);
+
+    if (got == sizeof(magic) && memcmp(magic, WORKLOAD_MAGIC, sizeof(magic)) == 0)
+        return workload_load_binary(filename, wl, err, errlen);
+    return workload_load_text(filename, wl, err, errlen);
+}
+
+// -----------------------------
+// Escritura en streaming
+// -----------------------------
+enum { WRITER_BUF = 1 << 16, MAX_TEXT_LINE = 4 * 12 + 4 };
+
+static char *format_int(char *out, int v) {
+    char tmp[12];
+    int len = 0;
+    unsigned u = v < 0 ? 0u - (unsigned)v : (unsigned)v;
+    do {
+        tmp[len++] = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    if (v < 0)
+        *out++ = '-';
+    while (len)
+        *out++ = tmp[--len];
+    return out;
+}
+
+// bursts < 0: versión 1, sin sección de ráfagas
+static void write_header(uint8_t *header, uint64_t count, int64_t bursts) {
+    memset(header, 0, sizeof(workload_header_t));
+    memcpy(header, WORKLOAD_MAGIC, sizeof(WORKLOAD_MAGIC));
+    store_le32(header + offsetof(workload_header_t, version),
+               bursts < 0 ? WORKLOAD_VERSION : WORKLOAD_VERSION_IO);
+    store_le32(header + offsetof(workload_header_t, record_size),
+               sizeof(workload_record_t));
+    store_le64(header + offsetof(workload_header_t, count), count);
+    store_le64(header + offsetof(workload_header_t, bursts), bursts < 0 ? 0 : bursts);
+}
+
+int workload_writer_open(workload_writer_t *w, const char *filename, int binary,
+                         char *err, size_t errlen) {
+    w->f = fopen(filename, binary ? "wb" : "w");
+    if (!w->f)
+        return fail(err, errlen, "%s: %s", filename, strerror(errno));
+    w->buf = malloc(WRITER_BUF);
+    if (!w->buf) {
+        fclose(w->f);
+        return fail(err, errlen, "%s: out of memory", filename);
+    }
+    w->binary = binary;
+    w->len = 0;
+    w->count = 0;
+    w->filename = filename;
+    w->burst_counts = NULL;
+    w->counts_capacity = 0;
+    w->bursts = NULL;
+    w->num_bursts = 0;
+    w->bursts_capacity = 0;
+    w->failed = 0;
+
+    if (binary) {
+        // La cuenta real se escribe al cerrar
+        uint8_t header[sizeof(workload_header_t)];
+        write_header(header, 0, -1);
+        fwrite(header, 1, sizeof(header), w->f);
+    }
+    return 0;
+}
+
+static void writer_flush_if(workload_writer_t *w, size_t needed) {
+    if (w->len > WRITER_BUF - needed) {
+        fwrite(w->buf, 1, w->len, w->f);
+        w->len = 0;
+    }
+}
+
+// Binario: número de ráfagas de cada proceso desde que apareció el primero
+// con E/S (los anteriores quedan a 0)
+static void writer_count(workload_writer_t *w, uint32_t num_bursts) {
+    if (!w->burst_counts && num_bursts == 0)
+        return;
+    if (w->count >= w->counts_capacity) {
+        size_t cap = w->counts_capacity > 0 ? w->counts_capacity * 2 : 1024;
+        while (cap <= w->count)
+            cap *= 2;
+        uint32_t *c = realloc(w->burst_counts, cap * sizeof(uint32_t));
+        if (!c) {
+            w->failed = 1;
+            return;
+        }
+        memset(c + w->counts_capacity, 0, (cap - w->counts_capacity) * sizeof(uint32_t));
+        w->burst_counts = c;
+        w->counts_capacity = cap;
+    }
+    w->burst_counts[w->count] = num_bursts;
+}
+
+static void writer_record(workload_writer_t *w, int pid, int arrival, int burst,
+                          int priority) {
+    writer_flush_if(w, MAX_TEXT_LINE);
+    char *o = w->buf + w->len;
+    store_le32(o, pid);
+    store_le32(o + 4, arrival);
+    store_le32(o + 8, burst);
+    store_le32(o + 12, priority);
+    w->len += sizeof(workload_record_t);
+}
+
+void workload_writer_add(workload_writer_t *w, int pid, int arrival, int burst,
+                         int priority) {
+    if (w->binary) {
+        writer_record(w, pid, arrival, burst, priority);
+        writer_count(w, 0);
+        w->count++;
+        return;
+    }
+    writer_flush_if(w, MAX_TEXT_LINE);
+    char *o = w->buf + w->len;
+    o = format_int(o, pid);      *o++ = ' ';
+    o = format_int(o, arrival);  *o++ = ' ';
+    o = format_int(o, burst);    *o++ = ' ';
+    o = format_int(o, priority); *o++ = '\n';
+    w->len = o - w->buf;
+    w->count++;
+}
+
+void workload_writer_add_bursts(workload_writer_t *w, int pid, int arrival,
+                                int priority, const int *bursts, int num_bursts) {
+    if (num_bursts <= 1) {
+        workload_writer_add(w, pid, arrival, num_bursts == 1 ? bursts[0] : 0, priority);
+        return;
+    }
+    if (!w->binary) {
+        // "pid arrival cpu priority io cpu ...", por trozos si es muy larga
+        workload_writer_add(w, pid, arrival, bursts[0], priority);
+        w->len--;
+        for (int k = 1; k < num_bursts; k++) {
+            writer_flush_if(w, 13);
+            char *o = w->buf + w->len;
+            *o++ = ' ';
+            o = format_int(o, bursts[k]);
+            w->len = o - w->buf;
+        }
+        w->buf[w->len++] = '\n';
+        return;
+    }
+
+    long long cpu = 0;
+    for (int k = 0; k < num_bursts; k += 2)
+        cpu += bursts[k];
+    writer_record(w, pid, arrival, (int)cpu, priority);
+    writer_count(w, (uint32_t)num_bursts);
+    w->count++;
+    if (w->num_bursts + num_bursts > w->bursts_capacity) {
+        size_t cap = w->bursts_capacity > 0 ? w->bursts_capacity : 1024;
+        while (cap < w->num_bursts + num_bursts)
+            cap *= 2;
+        int32_t *b = realloc(w->bursts, cap * sizeof(int32_t));
+        if (!b) {
+            w->failed = 1;
+            return;
+        }
+        w->bursts = b;
+        w->bursts_capacity = cap;
+    }
+    memcpy(w->bursts + w->num_bursts, bursts, num_bursts * sizeof(int32_t));
+    w->num_bursts += num_bursts;
+}
+
+// Vuelca n enteros de 32 bits en little-endian a través del buffer
+static void writer_words(workload_writer_t *w, const void *words, size_t n) {
+    const uint32_t *v = words;
+    for (size_t i = 0; i < n; i++) {
+        writer_flush_if(w, 4);
+        store_le32(w->buf + w->len, v[i]);
+        w->len += 4;
+    }
+}
+
+int workload_writer_close(workload_writer_t *w, char *err, size_t errlen) {
+    int64_t bursts = -1;
+    if (w->binary && w->burst_counts && !w->failed) {
+        writer_words(w, w->burst_counts, w->count);
+        writer_words(w, w->bursts, w->num_bursts);
+        bursts = (int64_t)w->num_bursts;
+    }
+    fwrite(w->buf, 1, w->len, w->f);
+    free(w->buf);
+    free(w->burst_counts);
+    free(w->bursts);
+    w->buf = NULL;
+    w->burst_counts = NULL;
+    w->bursts = NULL;
+
+    int ok = !ferror(w->f) && !w->failed;
+    if (ok && w->binary) {
+        uint8_t header[sizeof(workload_header_t)];
+        write_header(header, w->count, bursts);
+        ok = fseek(w->f, 0, SEEK_SET) == 0 &&
+             fwrite(header, 1, sizeof(header), w->f) == sizeof(header);
+    }
+    if (fclose(w->f) != 0)
+        ok = 0;
+    w->f = NULL;
+    if (ok)
+        return 0;
+    return fail(err, errlen, w->failed ? "%s: out of memory for the burst section"
+                                       : "%s: write error", w->filename);
+}
+
+static int save(const char *filename, int binary, const process_t *processes,
+                int n, char *err, size_t errlen) {
+    workload_writer_t w;
+    if (workload_writer_open(&w, filename, binary, err, errlen) != 0)
+        return -1;
+    for (int i = 0; i < n; i++) {
+        const process_t *p = &processes[i];
+        if (p->num_bursts > 1)
+            workload_writer_add_bursts(&w, p->pid, p->arrival_time, p->priority,
+                                       p->bursts, p->num_bursts);
+        else
+            workload_writer_add(&w, p->pid, p->arrival_time, p->burst_time, p->priority);
+    }
+    return workload_writer_close(&w, err, errlen);
+}
+
+int workload_save_text(const char *filename, const process_t *processes, int n,
+                       char *err, size_t errlen) {
+    return save(filename, 0, processes, n, err, errlen);
+}
+
+int workload_save_binary(const char *filename, const process_t *processes, int n,
+                         char *err, size_t errlen) {
+    return save(filename, 1, processes, n, err, errlen);
+}
@@ -5,15 +5,17 @@
 
 int main() {
     process_t processes[] = {
-        {1, 0, 5, 1, 0,0,0,0,0,0},
-        {2, 2, 3, 2, 0,0,0,0,0,0},
-        {3, 4, 2, 1, 0,0,0,0,0,0}
+        {1, 0, 5, 1, 0,0,0,0,0,0, 0,0,NULL},
+        {2, 2, 3, 2, 0,0,0,0,0,0, 0,0,NULL},
+        {3, 4, 2, 1, 0,0,0,0,0,0, 0,0,NULL}
     };
     int n = 3;
-    timeline_event_t timeline[100];
+    timeline_t timeline;
     metrics_t m;
 
-    schedule_fifo(processes, n, timeline);
+    timeline_init(&timeline, 16);
+
+    schedule_fifo(processes, n, &timeline);
     calculate_metrics(processes, n, 10, &m);
 
     printf("FIFO Test\n");
@@ -27,5 +29,6 @@ int main() {
     }
     printf("Avg TAT: %.2f, Avg WT: %.2f, CPU Util: %.2f%%\n",
            m.avg_turnaround_time, m.avg_waiting_time, m.cpu_utilization);
+    timeline_free(&timeline);
     return 0;
 }
@@ -5,18 +5,20 @@
 
 int main() {
     process_t processes[] = {
-        {1, 0, 5, 1, 0,0,0,0,0,0},
-        {2, 1, 8, 2, 0,0,0,0,0,0},
-        {3, 2, 3, 1, 0,0,0,0,0,0}
+        {1, 0, 5, 1, 0,0,0,0,0,0, 0,0,NULL},
+        {2, 1, 8, 2, 0,0,0,0,0,0, 0,0,NULL},
+        {3, 2, 3, 1, 0,0,0,0,0,0, 0,0,NULL}
     };
     int n = 3;
-    timeline_event_t timeline[1000];
+    timeline_t timeline;
     metrics_t m;
 
+    timeline_init(&timeline, 16);
+
     int quantums[] = {2, 4};
-    mlfq_config_t config = {2, quantums, 50};
+    mlfq_config_t config = {2, quantums, 50, NULL};
 
-    schedule_mlfq(processes, n, &config, timeline);
+    schedule_mlfq(processes, n, &config, &timeline);
     calculate_metrics(processes, n, 15, &m);
 
     printf("MLFQ Test\n");
@@ -25,5 +27,6 @@ int main() {
                processes[i].pid, processes[i].start_time, processes[i].completion_time);
 
     printf("Avg TAT: %.2f, Avg WT: %.2f\n", m.avg_turnaround_time, m.avg_waiting_time);
+    timeline_free(&timeline);
     return 0;
 }
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <string.h>
+#include "scheduler.h"
+#include "algorithms.h"
+#include "generator.h"
+#include "resim.h"
+
+/* Tras cada tanda de ediciones aleatorias la re-simulación incremental
+ * debe dejar lo mismo que una ejecución completa desde 0 */
+
+static int quantums[3] = {2, 4, 8};
+static mlfq_config_t config = {3, quantums, 50, NULL};
+
+/* Generador propio para que la secuencia no dependa de la libc */
+static unsigned next_rand(unsigned *state) {
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
+
+/* 0 si rs->pt y rs->timeline coinciden con una ejecución completa */
+static int compare(resim_t *rs) {
+    proc_table_t ref;
+    timeline_t timeline;
+    if (proc_table_init_shared(&ref, &rs->pt) != 0 || timeline_init(&timeline, 64) != 0)
+        return -1;
+    timeline_sink_t sink = timeline_as_sink(&timeline);
+    int bad = schedule_run_table(rs->alg, &ref, rs->quantum, rs->config, &sink) != 0;
+    for (int i = 0; i < ref.n && !bad; i++)
+        bad = ref.start[i] != rs->pt.start[i] || ref.completion[i] != rs->pt.completion[i];
+    if (!bad)
+        bad = timeline.count != rs->timeline.count ||
+              memcmp(timeline.events, rs->timeline.events,
+                     timeline.count * sizeof(timeline_event_t)) != 0;
+    timeline_free(&timeline);
+    proc_table_free(&ref);
+    return bad;
+}
+
+int main() {
+    const char *workloads[] = { "n=300,seed=11", "n=300,seed=12,io=1" };
+    int failures = 0;
+    unsigned state = 1;
+
+    printf("Incremental Resim Test\n");
+    for (int w = 0; w < 2; w++) {
+        for (int alg = 0; alg < SCHED_COUNT; alg++) {
+            gen_spec_t spec;
+            workload_t wl;
+            resim_t rs;
+            gen_spec_default(&spec);
+            gen_spec_parse(&spec, workloads[w], NULL, 0);
+            workload_init(&wl);
+            if (generate_workload(&spec, &wl, NULL, 0) != 0 || resim_init(&rs, 16) != 0 ||
+                resim_load(&rs, wl.processes, wl.n) != 0) {
+                printf("setup failed\n");
+                return 1;
+            }
+            resim_set_policy(&rs, alg, 3, &config);
+
+            int runs = 0, bad = 0;
+            long long incremental = 0;
+            for (int e = 0; e < 60 && !bad; e++) {
+                if (next_rand(&state) % 2 && rs.pt.n > 1) {
+                    resim_remove(&rs, next_rand(&state) % rs.pt.n);
+                } else {
+                    process_t p = wl.processes[next_rand(&state) % wl.n];
+                    p.pid = 1000 + e;
+                    p.arrival_time += next_rand(&state) % 100;
+                    resim_add(&rs, &p);
+                }
+                /* Varias ediciones por ejecución */
+                if (next_rand(&state) % 3 == 0 || e == 59) {
+                    bad = resim_run(&rs) != 0 || compare(&rs) != 0;
+                    incremental += rs.resumed_at > 0;
+                    runs++;
+                }
+            }
+            printf("%s %s: %d runs, %lld resumed from a snapshot: %s\n",
+                   workloads[w], sched_alg_name(alg), runs, incremental,
+                   bad ? "MISMATCH" : "ok");
+            failures += bad;
+            resim_free(&rs);
+            workload_free(&wl);
+        }
+    }
+    return failures != 0;
+}
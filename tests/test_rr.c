@@ -3,18 +3,32 @@
 #include "algorithms.h"
 #include "metrics.h"
 
+/* Sink de streaming: sólo cuenta eventos y tiempo de CPU */
+typedef struct {
+    int events;
+    int busy;
+} count_ctx_t;
+
+static void count_event(void *ctx, const timeline_event_t *ev) {
+    count_ctx_t *c = ctx;
+    c->events++;
+    c->busy += ev->duration;
+}
+
 int main() {
     process_t processes[] = {
-        {1, 0, 5, 1, 0,0,0,0,0,0},
-        {2, 1, 3, 2, 0,0,0,0,0,0},
-        {3, 2, 7, 1, 0,0,0,0,0,0}
+        {1, 0, 5, 1, 0,0,0,0,0,0, 0,0,NULL},
+        {2, 1, 3, 2, 0,0,0,0,0,0, 0,0,NULL},
+        {3, 2, 7, 1, 0,0,0,0,0,0, 0,0,NULL}
     };
     int n = 3;
     int quantum = 3;
-    timeline_event_t timeline[1000];
+    timeline_t timeline;
     metrics_t m;
 
-    schedule_rr(processes, n, quantum, timeline);
+    timeline_init(&timeline, 16);
+
+    schedule_rr(processes, n, quantum, &timeline);
     calculate_metrics(processes, n, 15, &m);
 
     printf("Round Robin Test (q=%d)\n", quantum);
@@ -23,5 +37,12 @@ int main() {
                processes[i].pid, processes[i].start_time, processes[i].completion_time);
 
     printf("Avg TAT: %.2f, Avg WT: %.2f\n", m.avg_turnaround_time, m.avg_waiting_time);
+
+    count_ctx_t counts = {0, 0};
+    timeline_sink_t sink = {count_event, NULL, &counts};
+    schedule_rr_stream(processes, n, quantum, &sink);
+    printf("Streamed events: %d (stored: %d), busy time: %d\n",
+           counts.events, timeline.count, counts.busy);
+    timeline_free(&timeline);
     return 0;
 }
@@ -5,15 +5,17 @@
 
 int main() {
     process_t processes[] = {
-        {1, 0, 5, 1, 0,0,0,0,0,0},
-        {2, 1, 3, 2, 0,0,0,0,0,0},
-        {3, 2, 2, 1, 0,0,0,0,0,0}
+        {1, 0, 5, 1, 0,0,0,0,0,0, 0,0,NULL},
+        {2, 1, 3, 2, 0,0,0,0,0,0, 0,0,NULL},
+        {3, 2, 2, 1, 0,0,0,0,0,0, 0,0,NULL}
     };
     int n = 3;
-    timeline_event_t timeline[100];
+    timeline_t timeline;
     metrics_t m;
 
-    schedule_sjf(processes, n, timeline);
+    timeline_init(&timeline, 16);
+
+    schedule_sjf(processes, n, &timeline);
     calculate_metrics(processes, n, 10, &m);
 
     printf("SJF Test\n");
@@ -23,5 +25,8 @@ int main() {
 
     printf("Avg TAT: %.2f, Avg WT: %.2f\n",
            m.avg_turnaround_time, m.avg_waiting_time);
+    printf("WT p50: %d, p99: %d, max: %d\n",
+           m.waiting.p50, m.waiting.p99, m.waiting.max);
+    timeline_free(&timeline);
     return 0;
 }
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <string.h>
+#include "scheduler.h"
+#include "algorithms.h"
+#include "generator.h"
+#include "smp.h"
+
+/* push y steal deben dar lo mismo con uno o varios hilos, y con una CPU
+ * cualquier modo debe coincidir con schedule_run_table */
+
+static int quantums[3] = {2, 4, 8};
+static mlfq_config_t config = {3, quantums, 50, NULL};
+
+typedef struct {
+    proc_table_t pt;
+    timeline_t timeline;
+    smp_stats_t stats;
+} run_t;
+
+/* smp_run (cfg != NULL) o schedule_run_table sobre una copia de src */
+static int run(run_t *r, sched_alg_t alg, const proc_table_t *src,
+               const smp_config_t *cfg) {
+    memset(&r->stats, 0, sizeof(r->stats));
+    if (proc_table_init_shared(&r->pt, src) != 0 || timeline_init(&r->timeline, 64) != 0)
+        return -1;
+    timeline_sink_t sink = timeline_as_sink(&r->timeline);
+    if (cfg)
+        return smp_run(alg, &r->pt, 3, &config, cfg, &sink, &r->stats);
+    return schedule_run_table(alg, &r->pt, 3, &config, &sink);
+}
+
+static void run_free(run_t *r) {
+    proc_table_free(&r->pt);
+    timeline_free(&r->timeline);
+    smp_stats_free(&r->stats);
+}
+
+/* 0 si las dos ejecuciones dejan la misma tabla y la misma línea de tiempo */
+static int same(const run_t *a, const run_t *b) {
+    for (int i = 0; i < a->pt.n; i++)
+        if (a->pt.start[i] != b->pt.start[i] || a->pt.completion[i] != b->pt.completion[i])
+            return 0;
+    return a->timeline.count == b->timeline.count &&
+           memcmp(a->timeline.events, b->timeline.events,
+                  a->timeline.count * sizeof(timeline_event_t)) == 0;
+}
+
+int main() {
+    gen_spec_t spec;
+    workload_t wl;
+    proc_table_t pt;
+    int failures = 0;
+
+    gen_spec_default(&spec);
+    gen_spec_parse(&spec, "n=2000,seed=5,rate=0.5", NULL, 0);
+    workload_init(&wl);
+    if (generate_workload(&spec, &wl, NULL, 0) != 0 ||
+        proc_table_from_processes(&pt, wl.processes, wl.n) != 0) {
+        printf("setup failed\n");
+        return 1;
+    }
+
+    printf("SMP Test (%d processes)\n", pt.n);
+    for (int alg = 0; alg < SCHED_COUNT; alg++) {
+        /* Uno frente a varios hilos con 4 CPUs */
+        for (smp_balance_t b = SMP_PUSH; b <= SMP_STEAL; b++) {
+            smp_config_t cfg;
+            run_t one, many;
+            smp_config_default(&cfg);
+            cfg.num_cpus = 4;
+            cfg.balance = b;
+            cfg.threads = 1;
+            int rc = run(&one, alg, &pt, &cfg);
+            cfg.threads = 4;
+            rc |= run(&many, alg, &pt, &cfg);
+            int ok = rc == 0 && same(&one, &many) &&
+                     one.stats.migrations == many.stats.migrations &&
+                     one.stats.switches == many.stats.switches;
+            printf("%s %s -j 1 vs -j 4: makespan %d, migrations %lld: %s\n",
+                   sched_alg_name(alg), smp_balance_name(b), one.stats.makespan,
+                   one.stats.migrations, ok ? "ok" : "MISMATCH");
+            failures += !ok;
+            run_free(&one);
+            run_free(&many);
+        }
+
+        /* Una CPU frente a la simulación de siempre */
+        run_t ref;
+        int rc = run(&ref, alg, &pt, NULL);
+        for (smp_balance_t b = SMP_GLOBAL; b < SMP_BALANCE_COUNT; b++) {
+            smp_config_t cfg;
+            run_t single;
+            smp_config_default(&cfg);
+            cfg.num_cpus = 1;
+            cfg.balance = b;
+            int ok = (rc | run(&single, alg, &pt, &cfg)) == 0 && same(&ref, &single);
+            printf("%s %s -P 1 vs schedule_run_table: %s\n",
+                   sched_alg_name(alg), smp_balance_name(b), ok ? "ok" : "MISMATCH");
+            failures += !ok;
+            run_free(&single);
+        }
+        run_free(&ref);
+    }
+    proc_table_free(&pt);
+    workload_free(&wl);
+    return failures != 0;
+}
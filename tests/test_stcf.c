@@ -5,15 +5,17 @@
 
 int main() {
     process_t processes[] = {
-        {1, 0, 8, 1, 0,0,0,0,0,0},
-        {2, 1, 4, 2, 0,0,0,0,0,0},
-        {3, 2, 2, 1, 0,0,0,0,0,0}
+        {1, 0, 8, 1, 0,0,0,0,0,0, 0,0,NULL},
+        {2, 1, 4, 2, 0,0,0,0,0,0, 0,0,NULL},
+        {3, 2, 2, 1, 0,0,0,0,0,0, 0,0,NULL}
     };
     int n = 3;
-    timeline_event_t timeline[1000];
+    timeline_t timeline;
     metrics_t m;
 
-    schedule_stcf(processes, n, timeline);
+    timeline_init(&timeline, 16);
+
+    schedule_stcf(processes, n, &timeline);
     calculate_metrics(processes, n, 10, &m);
 
     printf("STCF Test\n");
@@ -23,5 +25,7 @@ int main() {
 
     printf("Avg TAT: %.2f, Avg WT: %.2f, CPU Util: %.2f%%\n",
            m.avg_turnaround_time, m.avg_waiting_time, m.cpu_utilization);
+    printf("Timeline events: %d\n", timeline.count);
+    timeline_free(&timeline);
     return 0;
 }
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "scheduler.h"
+#include "workload.h"
+
+/* Conversión texto <-> binario (versiones 1 y 2) y rechazo de cabeceras
+ * y registros mal formados, por los dos cargadores binarios */
+
+static char text_path[64], bin_path[64], bad_path[64];
+
+static void put32(FILE *f, uint32_t v) {
+    unsigned char b[4] = { v, v >> 8, v >> 16, v >> 24 };
+    fwrite(b, 1, 4, f);
+}
+
+static void put64(FILE *f, uint64_t v) {
+    put32(f, (uint32_t)v);
+    put32(f, (uint32_t)(v >> 32));
+}
+
+/* Archivo binario a mano: records[i] = {pid, arrival, burst, priority};
+ * counts/bursts sólo en la versión 2 */
+static void write_binary(const char *path, const char *magic, uint32_t version,
+                         uint32_t record_size, uint64_t count, const int (*records)[4],
+                         int num_records, const int *counts, const int *bursts,
+                         uint64_t num_bursts) {
+    FILE *f = fopen(path, "wb");
+    fwrite(magic, 1, 8, f);
+    put32(f, version);
+    put32(f, record_size);
+    put64(f, count);
+    put64(f, num_bursts);
+    for (int i = 0; i < num_records; i++)
+        for (int k = 0; k < 4; k++)
+            put32(f, (uint32_t)records[i][k]);
+    for (int i = 0; counts && i < num_records; i++)
+        put32(f, (uint32_t)counts[i]);
+    for (uint64_t i = 0; bursts && i < num_bursts; i++)
+        put32(f, (uint32_t)bursts[i]);
+    fclose(f);
+}
+
+static int same_workload(const workload_t *a, const workload_t *b) {
+    if (a->n != b->n)
+        return 0;
+    for (int i = 0; i < a->n; i++) {
+        const process_t *p = &a->processes[i], *q = &b->processes[i];
+        if (p->pid != q->pid || p->arrival_time != q->arrival_time ||
+            p->burst_time != q->burst_time || p->priority != q->priority ||
+            (p->num_bursts > 1) != (q->num_bursts > 1))
+            return 0;
+        if (p->num_bursts > 1 && (p->num_bursts != q->num_bursts ||
+            memcmp(p->bursts, q->bursts, p->num_bursts * sizeof(int)) != 0))
+            return 0;
+    }
+    return 1;
+}
+
+/* Los dos cargadores deben rechazar bad_path; imprime el motivo sin la ruta */
+static int rejected(const char *name) {
+    char err[256], view_err[256];
+    workload_t wl;
+    workload_view_t view;
+    workload_init(&wl);
+    int loaded = workload_load_binary(bad_path, &wl, err, sizeof(err)) == 0;
+    int mapped = workload_map_binary(bad_path, &view, view_err, sizeof(view_err)) == 0;
+    if (mapped)
+        workload_unmap(&view);
+    workload_free(&wl);
+    int ok = !loaded && !mapped && strcmp(err, view_err) == 0;
+    printf("%-22s %s (%s)\n", name, ok ? "rejected" : "ACCEPTED",
+           loaded ? "-" : err + strlen(bad_path) + 2);
+    return ok;
+}
+
+int main() {
+    char err[256];
+    int failures = 0;
+    snprintf(text_path, sizeof(text_path), "/tmp/test_workload_%d.txt", (int)getpid());
+    snprintf(bin_path, sizeof(bin_path), "/tmp/test_workload_%d.bin", (int)getpid());
+    snprintf(bad_path, sizeof(bad_path), "/tmp/test_workload_%d.bad", (int)getpid());
+
+    printf("Workload Round-trip Test\n");
+    FILE *f = fopen(text_path, "w");
+    fprintf(f, "# pid arrival burst priority [io burst]...\n"
+               "1 0 8 1\n"
+               "2 1 4 2 10 3 5 2   # con E/S\n"
+               "\n"
+               "3 2 2 1\n"
+               "4 3 1 0 7 1\n");
+    fclose(f);
+
+    /* Texto -> binario (versión 2) -> texto */
+    workload_t text, bin, back;
+    workload_init(&text);
+    workload_init(&bin);
+    workload_init(&back);
+    int rc = workload_load_text(text_path, &text, err, sizeof(err));
+    rc |= workload_save_binary(bin_path, text.processes, text.n, err, sizeof(err));
+    rc |= workload_load(bin_path, &bin, err, sizeof(err));
+    rc |= workload_save_text(text_path, bin.processes, bin.n, err, sizeof(err));
+    rc |= workload_load(text_path, &back, err, sizeof(err));
+    int ok = rc == 0 && text.n == 4 && same_workload(&text, &bin) &&
+             same_workload(&text, &back);
+    printf("text -> v2 -> text: %d processes, %zu I/O bursts: %s\n",
+           bin.n, bin.num_bursts, ok ? "ok" : "MISMATCH");
+    failures += !ok;
+
+    workload_view_t view;
+    ok = workload_map_binary(bin_path, &view, err, sizeof(err)) == 0 &&
+         view.count == 4 && view.burst_counts && view.burst_counts[0] == 0 &&
+         view.burst_counts[1] == 5 && view.num_bursts == 8;
+    if (ok)
+        workload_unmap(&view);
+    printf("v2 view: %s\n", ok ? "ok" : "MISMATCH");
+    failures += !ok;
+
+    /* Sin E/S se escribe la versión 1 */
+    workload_free(&bin);
+    workload_init(&bin);
+    process_t plain[] = {
+        {1, 0, 8, 1, 0,0,0,0,0,0, 0,0,NULL},
+        {2, 5, 3, 0, 0,0,0,0,0,0, 0,0,NULL}
+    };
+    rc = workload_save_binary(bin_path, plain, 2, err, sizeof(err));
+    rc |= workload_load_binary(bin_path, &bin, err, sizeof(err));
+    ok = rc == 0 && workload_map_binary(bin_path, &view, err, sizeof(err)) == 0;
+    if (ok) {
+        ok = view.count == 2 && !view.burst_counts && bin.n == 2 &&
+             bin.processes[1].arrival_time == 5 && bin.processes[1].burst_time == 3;
+        workload_unmap(&view);
+    }
+    printf("v1 round-trip: %s\n", ok ? "ok" : "MISMATCH");
+    failures += !ok;
+
+    /* Cabeceras */
+    const int good[2][4] = { {1, 0, 5, 0}, {2, 1, 3, 0} };
+    write_binary(bad_path, "SCHEDXX", 1, 16, 2, good, 2, NULL, NULL, 0);
+    failures += !rejected("bad magic");
+    write_binary(bad_path, WORKLOAD_MAGIC, 3, 16, 2, good, 2, NULL, NULL, 0);
+    failures += !rejected("bad version");
+    write_binary(bad_path, WORKLOAD_MAGIC, 1, 12, 2, good, 2, NULL, NULL, 0);
+    failures += !rejected("bad record size");
+    write_binary(bad_path, WORKLOAD_MAGIC, 1, 16, 3, good, 2, NULL, NULL, 0);
+    failures += !rejected("truncated records");
+    const int none[2] = { 0, 0 };
+    write_binary(bad_path, WORKLOAD_MAGIC, 2, 16, 2, good, 2, none, NULL, 4);
+    failures += !rejected("truncated bursts");
+
+    /* Registros */
+    const int negative[2][4] = { {1, 0, 5, 0}, {2, 0, -5, 0} };
+    write_binary(bad_path, WORKLOAD_MAGIC, 1, 16, 2, negative, 2, NULL, NULL, 0);
+    failures += !rejected("v1 negative burst");
+    const int late[1][4] = { {1, 2147483000, 4000, 0} };
+    write_binary(bad_path, WORKLOAD_MAGIC, 1, 16, 1, late, 1, NULL, NULL, 0);
+    failures += !rejected("v1 end overflows");
+    const int early[2][4] = { {1, 0, 3, 0}, {2, -1, 3, 0} };
+    write_binary(bad_path, WORKLOAD_MAGIC, 1, 16, 2, early, 2, NULL, NULL, 0);
+    failures += !rejected("v1 negative arrival");
+
+    const int io[2][4] = { {1, 0, 3, 0}, {2, 0, 6, 0} };
+    const int counts[2] = { 0, 3 }, even[2] = { 0, 2 }, short_count[2] = { 0, 1 };
+    const int neg_run[3] = { 3, -2, 3 }, run[3] = { 3, 2, 3 };
+    write_binary(bad_path, WORKLOAD_MAGIC, 2, 16, 2, io, 2, counts, neg_run, 3);
+    failures += !rejected("v2 negative burst");
+    write_binary(bad_path, WORKLOAD_MAGIC, 2, 16, 2, io, 2, even, run, 3);
+    failures += !rejected("v2 even burst count");
+    write_binary(bad_path, WORKLOAD_MAGIC, 2, 16, 2, io, 2, short_count, run, 3);
+    failures += !rejected("v2 unused bursts");
+    const int late_io[1][4] = { {1, 2147483000, 6, 0} };
+    const int long_run[3] = { 3, 1000, 3 };
+    write_binary(bad_path, WORKLOAD_MAGIC, 2, 16, 1, late_io, 1, counts + 1, long_run, 3);
+    failures += !rejected("v2 end overflows");
+
+    workload_free(&text);
+    workload_free(&bin);
+    workload_free(&back);
+    remove(text_path);
+    remove(bin_path);
+    remove(bad_path);
+    return failures != 0;
+}